@@ -0,0 +1,169 @@
+/*
+ ============================================================================
+ Name        : arena.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the arena allocator declared in arena.h
+ Functions	 : myArena newArena ()
+                void *arenaAlloc (myArena a, long size)
+                void arenaStats (myArena a, long *bytes, long *nodes, long *chunks)
+                void resetArena (myArena a)
+                void mergeArena (myArena a, myArena b)
+                void clearArena (myArena a)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "./arena.h"
+
+
+/*****************
+ * Function:
+ *      newArena
+ * Description:
+ *      Create an empty arena (no chunk is allocated yet)
+ * Input:
+ *      none
+ * Output:
+ *      an arena ADT
+ *****************/
+myArena newArena () {
+    myArena a = malloc(sizeof(struct Arena));
+    a->first = NULL;
+    a->current = NULL;
+    a->used = 0;
+    a->bytes = 0;
+    a->nodes = 0;
+    a->chunks = 0;
+    return a;
+}
+
+
+/*****************
+ * Function:
+ *      arenaAlloc
+ * Description:
+ *      Take a block of memory from an arena: the pointer of the current
+ *      chunk is bumped. When the block does not fit, the arena moves on to
+ *      the next chunk it holds (after a reset), or to a new chunk.
+ * Input:
+ *      an arena ADT and the size of the block
+ * Output:
+ *      a pointer to the block
+ *****************/
+void *arenaAlloc (myArena a, long size) {
+    void *block;
+    size = (size + arenaAlign - 1) / arenaAlign * arenaAlign;
+
+    if (a->current == NULL || a->used + size > a->current->size) {
+        myArenaChunk next = (a->current == NULL) ? a->first : a->current->next;
+        if (next == NULL || next->size < size) {              // a new chunk, right after the current one
+            long chunkSize = (size > arenaChunk) ? size : arenaChunk;
+            myArenaChunk c = malloc(sizeof(struct ArenaChunk) + chunkSize);
+            c->size = chunkSize;
+            c->next = next;
+            if (a->current == NULL) a->first = c;
+            else a->current->next = c;
+            a->chunks++;
+            next = c;
+        }
+        a->current = next;
+        a->used = 0;
+    }
+
+    block = a->current->data + a->used;
+    a->used += size;
+    a->bytes += size;
+    a->nodes++;
+    return block;
+}
+
+
+/*****************
+ * Function:
+ *      arenaStats
+ * Description:
+ *      Tell how much an arena handed out since it was created or reset
+ * Input:
+ *      an arena ADT and where to put the stats (any of them may be NULL)
+ * Output:
+ *      bytes and blocks handed out, chunks held by the arena
+ *****************/
+void arenaStats (myArena a, long *bytes, long *nodes, long *chunks) {
+    if (bytes != NULL) *bytes = a->bytes;
+    if (nodes != NULL) *nodes = a->nodes;
+    if (chunks != NULL) *chunks = a->chunks;
+}
+
+
+/*****************
+ * Function:
+ *      resetArena
+ * Description:
+ *      Give back every block of an arena at once, the chunks are kept
+ * Input:
+ *      an arena ADT
+ * Output:
+ *      an arena with no block handed out
+ *****************/
+void resetArena (myArena a) {
+    a->current = NULL;
+    a->used = 0;
+    a->bytes = 0;
+    a->nodes = 0;
+}
+
+
+/*****************
+ * Function:
+ *      mergeArena
+ * Description:
+ *      Move the chunks of an arena into another one. The blocks of both
+ *      stay valid, and belong to the first arena from now on. The chunks
+ *      moved come first, so they read as used up until the next reset.
+ * Input:
+ *      two arena ADTs, the second one is freed
+ * Output:
+ *      the first arena holding the chunks of both
+ *****************/
+void mergeArena (myArena a, myArena b) {
+    myArenaChunk last;
+    if (b->first != NULL) {
+        for (last = b->first; last->next != NULL; last = last->next);
+        last->next = a->first;
+        a->first = b->first;
+        if (a->current == NULL && b->current != NULL) {     // nothing taken from a yet, go on in the last chunk of b
+            a->current = b->current;
+            a->used = b->used;
+        }
+    }
+    a->bytes += b->bytes;
+    a->nodes += b->nodes;
+    a->chunks += b->chunks;
+    free(b);
+}
+
+
+/*****************
+ * Function:
+ *      clearArena
+ * Description:
+ *      free up memory used by an arena ADT, chunks included
+ * Input:
+ *      an arena ADT
+ * Output:
+ *      released memory previously occupied by the arena ADT
+ *****************/
+void clearArena (myArena a) {
+    myArenaChunk c, next;
+    if (a == NULL) return;
+    for (c = a->first; c != NULL; c = next) {
+        next = c->next;
+        free(c);
+    }
+    free(a);
+}
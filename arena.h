@@ -0,0 +1,125 @@
+/*
+ ============================================================================
+ Name        : arena.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Arena allocator. Memory is handed out from large chunks by
+                bumping a pointer, and is never freed piece by piece: the
+                whole arena is reset (its chunks are kept and reused) or
+                cleared (its chunks are freed) at once, in O(1) for a reset.
+                The tree of a compilation lives in one arena (see buildTree.c),
+                so compiling many programs in one process neither leaks nor
+                fragments the heap.
+
+ ============================================================================
+ */
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+//configuration : size of a chunk, larger requests get a chunk of their own
+#define arenaChunk (65536)
+#define arenaAlign (16)                 // every block starts on this boundary
+
+typedef struct ArenaChunk *myArenaChunk;
+struct ArenaChunk {
+    myArenaChunk next;              // chunks are kept in the order they were used
+    long size;                      // bytes in data
+    char data[];
+};
+
+typedef struct Arena *myArena;
+struct Arena {
+    myArenaChunk first;             // first chunk, NULL until something is allocated
+    myArenaChunk current;           // chunk blocks are taken from
+    long used;                      // bytes taken from the current chunk
+    long bytes;                     // stats : bytes handed out since the last reset
+    long nodes;                     // stats : blocks handed out since the last reset
+    long chunks;                    // stats : chunks held by the arena
+};
+
+
+/*****************
+ * Function:
+ *      newArena
+ * Description:
+ *      Create an empty arena (no chunk is allocated yet)
+ * Input:
+ *      none
+ * Output:
+ *      an arena ADT
+ *****************/
+myArena newArena ();
+
+
+/*****************
+ * Function:
+ *      arenaAlloc
+ * Description:
+ *      Take a block of memory from an arena. The block is not cleared and
+ *      stays valid until the arena is reset or cleared.
+ * Input:
+ *      an arena ADT and the size of the block
+ * Output:
+ *      a pointer to the block
+ *****************/
+void *arenaAlloc (myArena a, long size);
+
+
+/*****************
+ * Function:
+ *      arenaStats
+ * Description:
+ *      Tell how much an arena handed out since it was created or reset
+ * Input:
+ *      an arena ADT and where to put the stats (any of them may be NULL)
+ * Output:
+ *      bytes and blocks handed out, chunks held by the arena
+ *****************/
+void arenaStats (myArena a, long *bytes, long *nodes, long *chunks);
+
+
+/*****************
+ * Function:
+ *      resetArena
+ * Description:
+ *      Give back every block of an arena at once. The chunks are kept and
+ *      reused by the next allocations.
+ * Input:
+ *      an arena ADT
+ * Output:
+ *      an arena with no block handed out
+ *****************/
+void resetArena (myArena a);
+
+
+/*****************
+ * Function:
+ *      mergeArena
+ * Description:
+ *      Move the chunks of an arena into another one, e.g. the nodes built
+ *      by a thread into the arena of the tree (see parallelParser.c). The
+ *      blocks of both stay valid until the first arena is reset or cleared.
+ * Input:
+ *      two arena ADTs, the second one is freed
+ * Output:
+ *      the first arena holding the chunks of both
+ *****************/
+void mergeArena (myArena a, myArena b);
+
+
+/*****************
+ * Function:
+ *      clearArena
+ * Description:
+ *      free up memory used by an arena ADT, chunks included
+ * Input:
+ *      an arena ADT
+ * Output:
+ *      released memory previously occupied by the arena ADT
+ *****************/
+void clearArena (myArena a);
+
+#endif
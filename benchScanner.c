@@ -0,0 +1,239 @@
+/*
+ ============================================================================
+ Name        : benchScanner.c
+ Author      : NGUYEN, TAM N
+ Created on  : 15OCT16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Scanner benchmark. The same source is tokenized with every
+                scanner engine (table-driven and direct-coded), once for each
+                instruction set of the run helpers (simdScan.h), then read as
+                a stream, block by block, and through a token stream scanning
+                with 1 to 8 threads (tokenStream.h).
+                The speed of each run is reported in tokens per second. The
+                tokens are also compared so all runs are known to agree.
+                Build with "make bench".
+                benchScanner [file name] [rounds]
+                    file name : source to scan (.fs16 is implicit), a large
+                                program is generated when none is given
+                    rounds    : number of times each run scans the source
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "./scanner.h"
+#include "./token.h"
+#include "./tokenStream.h"
+#include "./simdScan.h"
+
+
+static const char benchName[] = "benchScanner";
+static const char *engineNames[] = { "table", "direct" };
+static const char *simdNames[] = { "scalar", "sse2", "avx2" };
+
+
+/*****************
+ * Function:
+ *      writeProgram
+ * Description:
+ *      Generate a large program in benchScanner.fs16, built from
+ *      declarations, blocks, loops and expressions with a realistic
+ *      mix of identifiers, numbers, operators and indentation
+ * Input:
+ *      the number of statements to generate
+ * Output:
+ *      1 if the file was written, 0 otherwise
+ *****************/
+int writeProgram (long statements) {
+    char filename[64];
+    long i;
+    FILE *f;
+    snprintf(filename, sizeof(filename), "%s.fs16", benchName);
+    f = fopen(filename, "w");
+    if (f == NULL) return 0;
+    fprintf(f, "Var alpha : : beta : : gamma9 : : delta\nBegin\n");
+    for (i = 0; i<statements; i++) {
+        switch (i % 6) {
+            case 0: fprintf(f, "    alpha == beta * [ gamma9 + %ld ] - delta / 7 .\n", i); break;
+            case 1: fprintf(f, "    Loop [ alpha <=< %ld ]\n    Begin\n        Var counter%ld\n", i, i % 100); break;
+            case 2: fprintf(f, "        Print [ - alpha + beta ] .\n    End\n"); break;
+            case 3: fprintf(f, "    @note%ld\n    Scan : gamma9 .\n", i % 1000); break;
+            case 4: fprintf(f, "    [ delta =!= %ld ] Iff\n    Begin\n", i); break;
+            case 5: fprintf(f, "        delta == delta + 1 .\n    End\n"); break;
+        }
+    }
+    fprintf(f, "End\n");
+    return fclose(f) == 0;
+}
+
+
+/*****************
+ * Function:
+ *      runEngine
+ * Description:
+ *      Scan the whole source with one engine and time it
+ * Input:
+ *      file name (without extension), engine code, 1 to read the file as
+ *      a stream (scanByStream) instead of by name,
+ *      and where to store the token count and a checksum of the tokens
+ * Output:
+ *      elapsed time in seconds, a negative value if the file cannot be read
+ *****************/
+double runEngine (const char *name, int engine, int stream, long *count, unsigned long *checksum) {
+    char filename[256];
+    struct timespec start, stop;
+    myScanner s;
+    myToken t;
+    FILE *f = NULL;
+    int type;
+
+    snprintf(filename, sizeof(filename) - 8, "%s", name);
+    *count = 0;
+    *checksum = 5381;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (stream) {
+        strcat(filename, ".fs16");
+        f = fopen(filename, "r");
+        if (f == NULL) {
+            fprintf(stderr, "ERROR: file '%s' does not exist or not readable \n", filename);
+            return -1;
+        }
+        s = useEngine(scanByStream(f), engine);
+    } else s = useEngine(scanByName(filename), engine);
+    if (s == NULL) return -1;
+    do {
+        const char *c;
+        t = getToken(s);
+        type = t->tokenType;
+        *checksum = *checksum * 33 + type;
+        *checksum = *checksum * 33 + t->tokenLine;
+        for (c = t->tokenVal; *c; c++) *checksum = *checksum * 33 + *c;
+        (*count)++;
+        clearToken(t);
+    } while (type != eofCode);
+    clearScanner(s);
+    if (f != NULL) fclose(f);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    return (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+
+/*****************
+ * Function:
+ *      runStream
+ * Description:
+ *      Scan the whole source through a token stream and time it
+ * Input:
+ *      file name (without extension), number of threads,
+ *      and where to store the token count and a checksum of the tokens
+ * Output:
+ *      elapsed time in seconds, a negative value if the file cannot be read
+ *****************/
+double runStream (const char *name, int threads, long *count, unsigned long *checksum) {
+    char filename[256];
+    struct timespec start, stop;
+    myTokenStream ts;
+    myLexeme lx;
+    long i = 0;
+    int type;
+
+    snprintf(filename, sizeof(filename) - 8, "%s", name);
+    *checksum = 5381;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ts = openTokenStream(useThreads(scanByName(filename), threads));
+    if (ts == NULL) return -1;
+    do {
+        const char *c;
+        int k;
+        lx = streamToken(ts, i++);
+        type = lx->type;
+        *checksum = *checksum * 33 + type;
+        *checksum = *checksum * 33 + lx->line;
+        for (c = lexemeText(ts, lx), k = 0; k<lx->len; k++) *checksum = *checksum * 33 + c[k];
+    } while (type != eofCode);
+    *count = i;
+    clearScanner(ts->scanner);
+    clearTokenStream(ts);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    return (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+
+int main (int argc, char *argv[]) {
+    const char *name = benchName;
+    int rounds = 5;
+    int engine, r, generated = 0;
+    int level, best = simdLevel();
+    int threads;
+    unsigned long sums[2][3], streamSum;
+    int same = 1;
+
+    if (argc > 1) name = argv[1];
+    if (argc > 2) rounds = atoi(argv[2]);
+    if (rounds < 1) rounds = 1;
+    if (argc <= 1) {
+        if (writeProgram(400000) == 0) {
+            fprintf(stderr, "ERROR: cannot write %s.fs16 \n", benchName);
+            return EXIT_FAILURE;
+        }
+        generated = 1;
+    }
+
+    printf("%-8s %-7s %12s %10s %14s\n", "engine", "simd", "tokens", "seconds", "tokens/second");
+    for (engine = tableEngine; engine <= directEngine; engine++) {
+        for (level = simdScalar; level <= best; level++) {
+            double fastest = -1;
+            long count = 0;
+            simdSelect(level);
+            for (r = 0; r<rounds; r++) {
+                double elapsed = runEngine(name, engine, 0, &count, &sums[engine][level]);
+                if (elapsed < 0) return EXIT_FAILURE;             // scanByName reported it
+                if (fastest < 0 || elapsed < fastest) fastest = elapsed;
+            }
+            printf("%-8s %-7s %12ld %10.4f %14.0f\n", engineNames[engine], simdNames[level], count, fastest, count / fastest);
+            if (sums[engine][level] != sums[tableEngine][simdScalar]) same = 0;
+        }
+    }
+    simdSelect(best);
+    for (engine = tableEngine; engine <= directEngine; engine++) {
+        double fastest = -1;
+        long count = 0;
+        unsigned long sum;
+        for (r = 0; r<rounds; r++) {
+            double elapsed = runEngine(name, engine, 1, &count, &sum);
+            if (elapsed < 0) return EXIT_FAILURE;
+            if (fastest < 0 || elapsed < fastest) fastest = elapsed;
+        }
+        printf("%-8s %-7s %12ld %10.4f %14.0f\n", engineNames[engine], "blocks", count, fastest, count / fastest);
+        if (sum != sums[tableEngine][simdScalar]) same = 0;
+    }
+    for (threads = 1; threads <= 8; threads *= 2) {
+        double fastest = -1;
+        long count = 0;
+        char label[16];
+        for (r = 0; r<rounds; r++) {
+            double elapsed = runStream(name, threads, &count, &streamSum);
+            if (elapsed < 0) return EXIT_FAILURE;
+            if (fastest < 0 || elapsed < fastest) fastest = elapsed;
+        }
+        snprintf(label, sizeof(label), "%d thr", threads);
+        printf("%-8s %-7s %12ld %10.4f %14.0f\n", "stream", label, count, fastest, count / fastest);
+        if (streamSum != sums[tableEngine][simdScalar]) same = 0;
+    }
+    printf("same tokens : %s\n", same ? "yes" : "NO");
+
+    if (generated) {
+        char filename[64];
+        snprintf(filename, sizeof(filename), "%s.fs16", benchName);
+        remove(filename);
+    }
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
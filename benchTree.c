@@ -0,0 +1,255 @@
+/*
+ ============================================================================
+ Name        : benchTree.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Tree layout benchmark. A program is parsed once into a Treeptr
+                tree, which is then converted to the flat layout (flatTree.h).
+                Two passes are timed on both layouts:
+                 - dump : the tree dump text, written to /dev/null
+                 - scan : a visit of every node, reading its kind and value
+                The dump of the flat tree is also compared with the one
+                written by TravPreOrder, so both layouts are known to agree.
+                Build with "make benchtree".
+                benchTree [file name] [rounds]
+                    file name : program to parse (.fs16 is implicit), a large
+                                program is generated when none is given
+                    rounds    : number of times each pass runs
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "./scanner.h"
+#include "./token.h"
+#include "./parser.h"
+#include "./buildTree.h"
+#include "./traversals.h"
+#include "./flatTree.h"
+#include "./stringTable.h"
+#include "./compiler.h"
+
+static const char benchName[] = "benchTree";
+volatile unsigned long sink;            // keeps the scans from being optimized away
+
+
+/*****************
+ * Function:
+ *      writeProgram
+ * Description:
+ *      Generate a large program in benchTree.fs16: statements and nested
+ *      blocks over a few variables declared once
+ * Input:
+ *      the number of statements to generate
+ * Output:
+ *      1 if the file was written, 0 otherwise
+ *****************/
+int writeProgram (long statements) {
+    char filename[64];
+    long i;
+    FILE *f;
+    snprintf(filename, sizeof(filename), "%s.fs16", benchName);
+    f = fopen(filename, "w");
+    if (f == NULL) return 0;
+    fprintf(f, "Var alpha : : beta : : gamma9 : : delta\nBegin\n");
+    for (i = 0; i<statements; i++) {
+        switch (i % 5) {
+            case 0: fprintf(f, "    alpha == beta * [ gamma9 + %ld ] - delta / 7 .\n", i); break;
+            case 1: fprintf(f, "    Loop [ alpha <=< %ld ]\n    Begin\n", i); break;
+            case 2: fprintf(f, "        Print [ - alpha + beta ] .\n    End\n"); break;
+            case 3: fprintf(f, "    Scan : gamma9 .\n    [ delta =!= %ld ] Iff\n    Begin\n", i); break;
+            case 4: fprintf(f, "        delta == delta + 1 .\n    End\n"); break;
+        }
+    }
+    fprintf(f, "End\n");
+    return fclose(f) == 0;
+}
+
+
+/*****************
+ * Function:
+ *      pointerDump
+ * Description:
+ *      The tree dump of a Treeptr tree (same text as TravPreOrder),
+ *      written to a stream
+ * Input:
+ *      a compilation context, a node, its level and an open stream
+ * Output:
+ *      the dump on the stream
+ *****************/
+void pointerDump (myCompiler c, Treeptr node, int level, FILE *out) {
+    int i;
+    for (i = 0; i<=level; i++) fputs("  ", out);
+    fprintf(out, "%s %s \n", node->data, (node->symbol != noSymbol) ? symbolName(c->symbols, node->symbol) : node->value);
+    for (i = 0; i<node->nChildren; i++) pointerDump(c, node->children[i], level + 1, out);
+}
+
+
+/*****************
+ * Function:
+ *      pointerScan
+ * Description:
+ *      Visit every node of a Treeptr tree, reading its kind and value
+ * Input:
+ *      a node
+ * Output:
+ *      a checksum of the kinds, lines and operators
+ *****************/
+unsigned long pointerScan (Treeptr node) {
+    unsigned long sum = node->data[1] * 31 + node->line * 7 + node->value[0];
+    int i;
+    for (i = 0; i<node->nChildren; i++) sum += pointerScan(node->children[i]);
+    return sum;
+}
+
+
+/*****************
+ * Function:
+ *      flatScan
+ * Description:
+ *      Visit every node of a flat tree, reading its kind and value
+ * Input:
+ *      a flat tree ADT
+ * Output:
+ *      a checksum of the kinds, lines and values
+ *****************/
+unsigned long flatScan (myFlatTree ft) {
+    unsigned long sum = 0;
+    int i;
+    for (i = 0; i<ft->count; i++) sum += ft->kind[i] * 31 + ft->line[i] * 7 + ft->value[i];
+    return sum;
+}
+
+
+//elapsed seconds between two times
+double seconds (struct timespec *start, struct timespec *stop) {
+    return (stop->tv_sec - start->tv_sec) + (stop->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+/*****************
+ * Function:
+ *      sameDump
+ * Description:
+ *      Compare the dump of a flat tree with the file written by TravPreOrder
+ * Input:
+ *      a flat tree ADT and the file name of the TravPreOrder dump
+ * Output:
+ *      1 if both texts are the same, 0 otherwise
+ *****************/
+int sameDump (myFlatTree ft, const char *filename) {
+    FILE *a = tmpfile(), *b = fopen(filename, "r");
+    int ca, cb, same = (a != NULL && b != NULL);
+    if (same) {
+        flatTreeDump(ft, a);
+        rewind(a);
+        do {
+            ca = fgetc(a);
+            cb = fgetc(b);
+        } while (ca == cb && ca != EOF);
+        same = (ca == cb);
+    }
+    if (a != NULL) fclose(a);
+    if (b != NULL) fclose(b);
+    return same;
+}
+
+
+int main (int argc, char *argv[]) {
+    const char *name = benchName;
+    char filename[256], treeFile[256];
+    int rounds = 5, r, generated = 0, same;
+    struct timespec start, stop;
+    double pointerBest[2] = { -1, -1 }, flatBest[2] = { -1, -1 }, convert;
+    unsigned long pointerSum = 0, flatSum = 0;
+    long bytes, nodes, chunks;
+    myScanner s;
+    myCompiler c;
+    myFlatTree ft;
+    FILE *null;
+
+    if (argc > 1) name = argv[1];
+    if (argc > 2) rounds = atoi(argv[2]);
+    if (rounds < 1) rounds = 1;
+    if (argc <= 1) {
+        if (writeProgram(100000) == 0) {
+            fprintf(stderr, "ERROR: cannot write %s.fs16 \n", benchName);
+            return EXIT_FAILURE;
+        }
+        generated = 1;
+    }
+    snprintf(filename, sizeof(filename), "%s", name);
+    snprintf(treeFile, sizeof(treeFile), "%s.bench.tree", name);
+
+    s = scanByName(filename);
+    if (s == NULL) return EXIT_FAILURE;                       // scanByName reported it
+    c = newCompiler(s);
+    parser(c);
+    if (c->tree == NULL) {
+        clearCompiler(c);
+        clearScanner(s);
+        return EXIT_FAILURE;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ft = flattenTree(c);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    convert = seconds(&start, &stop);
+
+    null = fopen("/dev/null", "w");
+    for (r = 0; r<rounds; r++) {
+        double elapsed;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        pointerDump(c, c->tree, 0, null);
+        clock_gettime(CLOCK_MONOTONIC, &stop);
+        elapsed = seconds(&start, &stop);
+        if (pointerBest[0] < 0 || elapsed < pointerBest[0]) pointerBest[0] = elapsed;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        flatTreeDump(ft, null);
+        clock_gettime(CLOCK_MONOTONIC, &stop);
+        elapsed = seconds(&start, &stop);
+        if (flatBest[0] < 0 || elapsed < flatBest[0]) flatBest[0] = elapsed;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        pointerSum += pointerScan(c->tree);
+        clock_gettime(CLOCK_MONOTONIC, &stop);
+        elapsed = seconds(&start, &stop);
+        if (pointerBest[1] < 0 || elapsed < pointerBest[1]) pointerBest[1] = elapsed;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        flatSum += flatScan(ft);
+        clock_gettime(CLOCK_MONOTONIC, &stop);
+        elapsed = seconds(&start, &stop);
+        if (flatBest[1] < 0 || elapsed < flatBest[1]) flatBest[1] = elapsed;
+    }
+    fclose(null);
+    sink = pointerSum + flatSum;
+
+    remove(treeFile);
+    TravPreOrder(c, c->tree, 0, treeFile);
+    same = sameDump(ft, treeFile);
+    remove(treeFile);
+
+    arenaStats(c->arena, &bytes, &nodes, &chunks);
+    printf("%-8s %10s %10s %10s\n", "pass", "pointer", "flat", "speedup");
+    printf("%-8s %10.4f %10.4f %9.2fx\n", "dump", pointerBest[0], flatBest[0], pointerBest[0] / flatBest[0]);
+    printf("%-8s %10.4f %10.4f %9.2fx\n", "scan", pointerBest[1], flatBest[1], pointerBest[1] / flatBest[1]);
+    printf("nodes : %d, converted in %.4f s\n", ft->count, convert);
+    printf("pointer layout : %ld bytes in %ld chunks, flat layout : %ld bytes\n", bytes, chunks,
+           (long) ft->count * (sizeof(unsigned char) + 5 * sizeof(int)));
+    printf("same dump : %s\n", same ? "yes" : "NO");
+
+    clearFlatTree(ft);
+    clearCompiler(c);
+    clearScanner(s);
+    if (generated) {
+        snprintf(filename, sizeof(filename), "%s.fs16", benchName);
+        remove(filename);
+    }
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
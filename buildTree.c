@@ -12,40 +12,127 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "buildTree.h"
+#include "stringTable.h"
 
+//the state of the tree is kept in the compilation context:
+//  c->labels      nodes created so far (see BSTNode.label)
+//  c->line        set by the parser to the line of its current token
+//  c->staleDepths 1 once adoptTree moved a subtree one level down
+//  c->arena       every node and child array of the tree, freed at once
 
 
-Treeptr insertNewNode(char data[25], char value [25], Treeptr parent_node){
-	Treeptr newNode = (Treeptr) malloc(sizeof(struct BSTNode));
-	strcpy(newNode->data,data);
-	strcpy(newNode->value,value);
+Treeptr insertNewNode(myCompiler c, const char *data, const char *value, Treeptr parent_node){
+	Treeptr newNode;
+	newNode = (Treeptr) arenaAlloc(c->arena, sizeof(struct BSTNode));
+	snprintf(newNode->data, sizeof(newNode->data), "%s", data);          //cut to fit, as the token text is
+	snprintf(newNode->value, sizeof(newNode->value), "%s", value);
 	if (parent_node==NULL) newNode->count=1;
 	else newNode->count = parent_node->count + 1;
-	newNode->left=newNode->right=NULL;
+	newNode->label = ++c->labels;
+	newNode->children = NULL;
+	newNode->nChildren = newNode->capChildren = 0;
 	if (parent_node == NULL) newNode->parent = NULL;
 	else newNode->parent = parent_node;
 	if (parent_node==NULL) newNode->scope = 0;
 	else if (strstr(newNode->value,"<block>")!=NULL) newNode->scope = parent_node->scope + 1;
 	else newNode->scope = parent_node->scope;
 	newNode->asmFlag = 0;
+	newNode->symbol = noSymbol;
+	newNode->slot = -1;
+	newNode->slotsEnd = -1;
+	newNode->line = c->line;
 	return newNode;
 }
 
-Treeptr buildTree(char data[25], char value[25], Treeptr parent_node){
+//add a node as the last child of parent_node (or as the root)
+Treeptr buildTree(myCompiler c, const char *data, const char *value, Treeptr parent_node){
 	Treeptr tempNode;
 	if(parent_node==NULL){               //if the current spot root
-		theTree=insertNewNode(data, value, theTree);
-		tempNode = theTree;
+		c->tree=insertNewNode(c, data, value, c->tree);
+		tempNode = c->tree;
 	} else {
-	    if (parent_node->left == NULL){
-	        parent_node->left = insertNewNode (data, value, parent_node );
-	        tempNode = parent_node->left;
-	    } else if (parent_node->right == NULL){
-	        parent_node->right = insertNewNode (data, value, parent_node );
-	        tempNode = parent_node->right;
-	    } else tempNode =  parent_node;
+	    tempNode = insertNewNode (c, data, value, parent_node );
+	    if (parent_node->nChildren == parent_node->capChildren) {      //make room, the old array stays in the arena
+	        Treeptr *children = parent_node->children;
+	        parent_node->capChildren = (parent_node->capChildren == 0) ? treeChildren : parent_node->capChildren * 2;
+	        parent_node->children = arenaAlloc(c->arena, parent_node->capChildren * sizeof(Treeptr));
+	        if (children != NULL) memcpy(parent_node->children, children, parent_node->nChildren * sizeof(Treeptr));
+	    }
+	    parent_node->children[parent_node->nChildren++] = tempNode;
 	}
 	return tempNode;
 }
+
+//an <ID> node for an interned identifier, its value is the name cut to fit
+Treeptr buildIdTree(myCompiler c, int symbol, Treeptr parent_node){
+	char name[25];
+	Treeptr tempNode;
+	snprintf(name, sizeof(name), "%s", symbolName(c->symbols, symbol));
+	tempNode = buildTree(c, "<ID>", name, parent_node);
+	tempNode->symbol = symbol;
+	return tempNode;
+}
+
+//insert a new node between a node and its parent: the new node takes the place
+//of child among its siblings and child becomes its first child
+//with a NULL child, the new node is only added as the last child of parent_node
+//the depths below child are left as they were, depthTree fixes them at once
+Treeptr adoptTree(myCompiler c, const char *data, const char *value, Treeptr parent_node, Treeptr child){
+	Treeptr tempNode;
+	int i;
+	if (child == NULL) return buildTree(c, data, value, parent_node);
+	tempNode = insertNewNode(c, data, value, child->parent);
+	tempNode->count = child->count;
+	if (child->parent == NULL) c->tree = tempNode;
+	else {
+	    for (i = child->parent->nChildren - 1; i>=0 && child->parent->children[i] != child; i--);
+	    child->parent->children[i] = tempNode;
+	}
+	tempNode->capChildren = treeChildren;
+	tempNode->children = arenaAlloc(c->arena, treeChildren * sizeof(Treeptr));
+	tempNode->children[tempNode->nChildren++] = child;
+	child->parent = tempNode;
+	c->staleDepths = 1;
+	return tempNode;
+}
+
+//set the depth of every node from the one of its parent, when adoptTree moved
+//subtrees; the nodes still to visit are kept on a stack, not on the call stack
+void depthTree(myCompiler c){
+	Treeptr *stack, node;
+	long n = 0, room = 256;
+	int i;
+	if (c->tree == NULL || c->staleDepths == 0) return;
+	stack = malloc(room * sizeof(Treeptr));
+	stack[n++] = c->tree;
+	while (n > 0) {
+	    node = stack[--n];
+	    if (n + node->nChildren > room) {
+	        while (n + node->nChildren > room) room *= 2;
+	        stack = realloc(stack, room * sizeof(Treeptr));
+	    }
+	    for (i = 0; i<node->nChildren; i++) {
+	        node->children[i]->count = node->count + 1;
+	        stack[n++] = node->children[i];
+	    }
+	}
+	free(stack);
+	c->staleDepths = 0;
+}
+
+//child i of a node, NULL if there is no such child
+Treeptr treeChild(Treeptr node, int i){
+	if (node == NULL || i < 0 || i >= node->nChildren) return NULL;
+	return node->children[i];
+}
+
+//forget the tree and give back its memory at once, the arena is kept for the next tree
+void clearTree(myCompiler c){
+	resetArena(c->arena);
+	c->tree = NULL;
+	c->labels = 0;
+	c->staleDepths = 0;
+}
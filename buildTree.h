@@ -13,23 +13,44 @@
 #ifndef BUILDTREE_H_
 #define BUILDTREE_H_
 
-//declare data type for a specific node in a BSTree
+#include "arena.h"
+#include "compiler.h"
+
+//declare data type for a specific node in the parsed tree
+//a node holds its children in one contiguous array, in order: a block holds
+//its declarations and statements side by side, so the depth of the tree
+//follows the nesting of the program, not its length
 typedef struct BSTNode* Treeptr;
 struct BSTNode{
 	char data[25];
 	char value[25];
-	int count;
+	int count;             // depth of the node, 1 for the root
+	int label;             // creation order of the node, names its labels and temporaries in the ASM
 	int scope;
-	int asmFlag;
-	Treeptr left;
-	Treeptr right;
+	int asmFlag;           // generateASM : 1 once the temporary of an <expr> is declared
+	int symbol;            // symbol ID of an identifier (see stringTable.h), noSymbol otherwise
+	int slot;              // storage slot of an identifier (see storage.h), -1 for none;
+	                       // of a <Loop>, the first slot of the variables of its body
+	int slotsEnd;          // <Loop> : the slot after the variables of its body
+	int line;              // source line of the token the node was built on
+	Treeptr *children;     // children, in the order they were added
+	int nChildren;
+	int capChildren;       // room in children
 	Treeptr parent;
 };
 
-Treeptr theTree;
-Treeptr tempTreeNode;
+//configuration : room for children of a new node, doubled when full
+#define treeChildren (2)
+
+//the tree of a compilation, its arena and its counters are kept in the
+//compilation context (see compiler.h): c->tree is the root
 //--
 
-Treeptr buildTree(char data[25], char value[25], Treeptr );
+Treeptr buildTree(myCompiler , const char *data, const char *value, Treeptr );
+Treeptr buildIdTree(myCompiler , int symbol, Treeptr );
+Treeptr adoptTree(myCompiler , const char *data, const char *value, Treeptr , Treeptr );
+void depthTree(myCompiler );
+Treeptr treeChild(Treeptr, int );
+void clearTree(myCompiler );
 
 #endif /* BUILDTREE_H_ */
@@ -0,0 +1,161 @@
+/*
+ ============================================================================
+ Name        : checkLib.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Check of the compiler library against the command line compiler.
+                Each program is compiled with compileSource by checkThreads
+                threads at once, and every result must hold the texts comp
+                wrote for it: the .asm and .tree files, and the messages of
+                its .expect file (see "make check", which runs comp first).
+                Build with "make check", CHECKFLAGS is added to the build
+                (e.g. CHECKFLAGS=-fsanitize=thread).
+                checkLib [file name] ...
+                    file name : program compiled by comp (.fs16 is implicit)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "./compiler.h"
+#include "./textBuffer.h"
+
+//configuration : threads calling compileSource at once
+#define checkThreads (8)
+//configuration : parser engine and threads of a compilation, those of main
+#define checkEngine (parallelDescent)
+#define checkScanThreads (4)
+
+//a program and the texts comp wrote for it
+struct CheckProgram {
+    const char *name;
+    char *source, *asmText, *treeText, *messages;
+    long sourceLen, asmLen, treeLen, messagesLen;
+};
+
+//the programs, shared by the threads, and the differences each thread found
+struct CheckJob {
+    struct CheckProgram *programs;
+    int nPrograms;
+    int failures;
+};
+
+
+/*****************
+ * Function:
+ *      readFile
+ * Description:
+ *      Read a whole file into memory of its own
+ * Input:
+ *      the name of the file and its extension, the length read
+ * Output:
+ *      the text, null terminated, and its length; an empty text if there
+ *      is no such file
+ *****************/
+char *readFile (const char *name, const char *ext, long *len) {
+    char filename[256];
+    char *text = malloc(1);
+    long n;
+    FILE *f;
+
+    *len = 0;
+    snprintf(filename, sizeof(filename), "%s%s", name, ext);
+    f = fopen(filename, "rb");
+    if (f != NULL) {
+        while (!feof(f) && !ferror(f)) {
+            text = realloc(text, *len + 4096 + 1);
+            n = fread(text + *len, 1, 4096, f);
+            *len += n;
+        }
+        fclose(f);
+    }
+    text[*len] = '\0';
+    return text;
+}
+
+
+/*****************
+ * Function:
+ *      sameText
+ * Description:
+ *      Compare a text of a result with the one comp wrote, and report a
+ *      difference
+ * Input:
+ *      the program, the kind of text, the text of the result and the one
+ *      comp wrote with its length
+ * Output:
+ *      1 if both texts are the same, 0 otherwise
+ *****************/
+int sameText (const char *name, const char *kind, myTextBuffer got, const char *expected, long len) {
+    if (got->len == len && memcmp(got->text, expected, len) == 0) return 1;
+    fprintf(stderr, "Check failed : %s, the %s of compileSource differs from comp's \n", name, kind);
+    return 0;
+}
+
+
+//compile every program once and compare the results, one thread
+static void *checkWorker (void *arg) {
+    struct CheckJob *job = arg;
+    struct CompileResult result;
+    struct CheckProgram *p;
+    int i;
+
+    memset(&result, 0, sizeof(result));
+    result.threads = checkScanThreads;
+    for (i = 0; i<job->nPrograms; i++) {
+        p = &job->programs[i];
+        compileSource(p->source, p->sourceLen, checkEngine, &result);
+        if (!sameText(p->name, "ASM", result.asmText, p->asmText, p->asmLen)) job->failures++;
+        if (!sameText(p->name, "tree dump", result.treeText, p->treeText, p->treeLen)) job->failures++;
+        if (!sameText(p->name, "messages", result.diagnostics, p->messages, p->messagesLen)) job->failures++;
+    }
+    clearCompileResult(&result);
+    return NULL;
+}
+
+
+int main (int argc, char *argv[]) {
+    struct CheckProgram *programs;
+    struct CheckJob jobs[checkThreads];
+    pthread_t threads[checkThreads];
+    long *messagesLen;
+    int i, failures = 0;
+
+    programs = calloc(argc, sizeof(struct CheckProgram));
+    for (i = 1; i<argc; i++) {
+        programs[i - 1].name = argv[i];
+        programs[i - 1].source = readFile(argv[i], ".fs16", &programs[i - 1].sourceLen);
+        programs[i - 1].asmText = readFile(argv[i], ".asm", &programs[i - 1].asmLen);
+        programs[i - 1].treeText = readFile(argv[i], ".tree", &programs[i - 1].treeLen);
+        programs[i - 1].messages = readFile(argv[i], ".expect", &programs[i - 1].messagesLen);
+        messagesLen = &programs[i - 1].messagesLen;                  // the last line is the exit status
+        if (*messagesLen > 0) (*messagesLen)--;
+        while (*messagesLen > 0 && programs[i - 1].messages[*messagesLen - 1] != '\n') (*messagesLen)--;
+    }
+
+    for (i = 0; i<checkThreads; i++) {
+        jobs[i].programs = programs;
+        jobs[i].nPrograms = argc - 1;
+        jobs[i].failures = 0;
+        pthread_create(&threads[i], NULL, checkWorker, &jobs[i]);
+    }
+    for (i = 0; i<checkThreads; i++) {
+        pthread_join(threads[i], NULL);
+        failures += jobs[i].failures;
+    }
+
+    for (i = 0; i<argc - 1; i++) {
+        free(programs[i].source);
+        free(programs[i].asmText);
+        free(programs[i].treeText);
+        free(programs[i].messages);
+    }
+    free(programs);
+    printf("%d programs compiled by %d threads at once, %d differences \n", argc - 1, checkThreads, failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
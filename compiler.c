@@ -0,0 +1,231 @@
+/*
+ ============================================================================
+ Name        : compiler.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the compilation context declared in compiler.h
+ Functions	 : myCompiler newCompiler(myScanner scanIt)
+                void clearCompiler(myCompiler c)
+                void diagnose(myCompiler c, FILE *stream, const char *format, ...)
+                void reportError(myCompiler c, FILE *stream, const char *format, ...)
+                void reportErrorList(myCompiler c, FILE *stream, const char *format, va_list args)
+                myTextBuffer resultText (myTextBuffer text)
+                int compileSource(const char *src, long len, int engine, struct CompileResult *result)
+                void clearCompileResult(struct CompileResult *result)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include "./compiler.h"
+#include "./parser.h"
+#include "./llParser.h"
+#include "./parallelParser.h"
+#include "./traversals.h"
+#include "./scopeCheck.h"
+#include "./exprDag.h"
+#include "./storage.h"
+
+
+/*****************
+ * Function:
+ *      newCompiler
+ * Description:
+ *      Create the context of one compilation
+ * Input:
+ *      the scanner ADT of the program
+ * Output:
+ *      a compilation context ADT, NULL if there is no scanner
+ *****************/
+myCompiler newCompiler(myScanner scanIt) {
+    myCompiler c;
+    if (scanIt == NULL) return NULL;
+    c = calloc(1, sizeof(struct Compiler));
+    c->scanner = scanIt;
+    c->symbols = scanIt->symbols;
+    c->tokens = NULL;
+    c->position = -1;
+    c->lastPosition = -1;
+    c->jobs = NULL;
+    c->t = NULL;
+    c->tree = NULL;
+    c->arena = newArena();
+    c->scopes = newScopeTable();
+    c->footer = newTextBuffer();
+    c->treeOut = c->asmOut = c->diagnostics = NULL;
+    return c;
+}
+
+
+/*****************
+ * Function:
+ *      clearCompiler
+ * Description:
+ *      free up memory used by a compilation context, its tree included
+ * Input:
+ *      a compilation context ADT (may be NULL)
+ * Output:
+ *      released memory previously occupied by the context
+ *****************/
+void clearCompiler(myCompiler c) {
+    if (c == NULL) return;
+    clearArena(c->arena);
+    clearScopeTable(c->scopes);
+    clearTextBuffer(c->footer);
+    free(c);
+}
+
+
+/*****************
+ * Function:
+ *      diagnose
+ * Description:
+ *      Report a message of the compilation, as fprintf would
+ * Input:
+ *      a compilation context ADT, the stream used without diagnostics,
+ *      a format and its arguments
+ * Output:
+ *      none
+ *****************/
+void diagnose(myCompiler c, FILE *stream, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    if (c->diagnostics != NULL) printTextList(c->diagnostics, format, args);
+    else vfprintf(stream, format, args);
+    va_end(args);
+}
+
+
+/*****************
+ * Function:
+ *      reportError
+ * Description:
+ *      Report an error of the program and count it, up to errorCap errors
+ * Input:
+ *      a compilation context ADT, the stream used without diagnostics,
+ *      a format (NULL for an error already reported) and its arguments
+ * Output:
+ *      none
+ *****************/
+void reportError(myCompiler c, FILE *stream, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    reportErrorList(c, stream, format, args);
+    va_end(args);
+}
+
+
+/*****************
+ * Function:
+ *      reportErrorList
+ * Description:
+ *      Same as reportError, with the arguments in a va_list (as vfprintf)
+ * Input:
+ *      a compilation context ADT, the stream used without diagnostics,
+ *      a format and its arguments
+ * Output:
+ *      none
+ *****************/
+void reportErrorList(myCompiler c, FILE *stream, const char *format, va_list args) {
+    if (c->errors >= errorCap) return;
+    c->errors++;
+    if (format != NULL) {
+        if (c->diagnostics != NULL) printTextList(c->diagnostics, format, args);
+        else vfprintf(stream, format, args);
+    }
+    if (c->errors == errorCap) {
+        diagnose(c, stderr, "[SYSTEM] Too many errors (%d), the rest of the program is not checked.\n", errorCap);
+    }
+}
+
+
+//a text of a result, new if the caller gave none, emptied otherwise
+static myTextBuffer resultText (myTextBuffer text) {
+    if (text == NULL) return newTextBuffer();
+    emptyText(text);
+    return text;
+}
+
+
+/*****************
+ * Function:
+ *      compileSource
+ * Description:
+ *      Compile a program held in memory, without any file: parse it, check
+ *      its scopes unless the engine says trustedSource, lay out its
+ *      storage if it says scopedStorage, share its expressions if it says
+ *      sharedExpressions, dump the tree and generate the ASM. The scanner
+ *      may use the threads of the result. The scanner and the context
+ *      write their messages to the diagnostics, the tree dump and the ASM
+ *      go to the texts of the result, the errors counted to its errors.
+ * Input:
+ *      the source and its length, the parser engine and the result
+ * Output:
+ *      1 if a tree was built and written, 0 otherwise; the texts and the
+ *      number of errors in the result
+ *****************/
+int compileSource(const char *src, long len, int engine, struct CompileResult *result) {
+    myScanner scanIt;
+    myCompiler c;
+    int built;
+
+    result->asmText = resultText(result->asmText);
+    result->treeText = resultText(result->treeText);
+    result->diagnostics = resultText(result->diagnostics);
+    result->errors = 0;
+    if (src == NULL || len < 0) {
+        printText(result->diagnostics, "ERROR: Content buffer is empty \n");
+        return 0;
+    }
+
+    scanIt = useThreads(scanByBuffer(src, len), result->threads);
+    scanIt->messages = result->diagnostics;
+    c = newCompiler(scanIt);
+    c->treeOut = result->treeText;
+    c->asmOut = result->asmText;
+    c->diagnostics = result->diagnostics;
+
+    if ((engine & engineMask) == tableParser) llParser(c);
+    else if ((engine & engineMask) == parallelDescent) parallelParser(c);
+    else parser(c);
+    if (!(engine & trustedSource)) scope_checkTree(c);
+    if (engine & scopedStorage) layoutStorage(c);
+    if (engine & sharedExpressions) shareTree(c);
+    built = (c->tree != NULL);
+    if (TravPreOrder(c, c->tree, 0, NULL) != 0) {
+        diagnose(c, stderr, "ERROR: Cannot write the tree dump \n");
+        built = 0;
+    }
+    if (generateASM(c, c->tree, NULL) != 0) {
+        diagnose(c, stderr, "ERROR: Cannot write the ASM \n");
+        built = 0;
+    }
+
+    result->errors = c->errors;
+    clearCompiler(c);
+    clearScanner(scanIt);
+    return built;
+}
+
+
+/*****************
+ * Function:
+ *      clearCompileResult
+ * Description:
+ *      free up the texts of a result and set them back to NULL
+ * Input:
+ *      a result given to compileSource
+ * Output:
+ *      released memory previously occupied by the texts
+ *****************/
+void clearCompileResult(struct CompileResult *result) {
+    clearTextBuffer(result->asmText);
+    clearTextBuffer(result->treeText);
+    clearTextBuffer(result->diagnostics);
+    result->asmText = result->treeText = result->diagnostics = NULL;
+}
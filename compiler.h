@@ -0,0 +1,207 @@
+/*
+ ============================================================================
+ Name        : compiler.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Compilation context. Everything one compilation reads and
+                writes lives in a context ADT, which is handed down to every
+                phase: the scanner (and its string table), the state of the
+                parser, the tree and its arena, the scope table and the ASM
+                footer. There is no global state left between the phases, so
+                several programs can be compiled at the same time, one
+                context each, on as many threads.
+                A context is only ever used by one thread at a time.
+                compileSource is the entry point for embedding the compiler
+                (see "make lib"): source in memory in, ASM, tree dump and
+                messages out in text buffers (textBuffer.h), no file involved.
+
+ ============================================================================
+ */
+
+#ifndef _COMPILER_H_
+#define _COMPILER_H_
+
+#include "./arena.h"
+#include "./scanner.h"
+#include "./token.h"
+#include "./tokenStream.h"
+#include "./stringTable.h"
+#include "./textBuffer.h"
+#include "./scopeTable.h"
+
+//configuration : errors reported by one compilation, the next ones are dropped and the parser stops (see reportError)
+#define errorCap (100)
+
+//configuration : parser engines, recursive descent (parser.c), LL(1) table (llParser.c)
+//or recursive descent with the nested blocks of the main block on threads (parallelParser.c)
+#define descentParser (0)
+#define tableParser (1)
+#define parallelDescent (2)
+//configuration : options or'ed with a parser engine (engineMask keeps the engine)
+#define engineMask (15)
+#define trustedSource (16)              // the scopes are not checked (trusted sources, see scope_checkTree)
+#define sharedExpressions (32)          // identical expressions are stored once (see shareTree)
+#define scopedStorage (64)              // variables of blocks not nested in one another share storage (see layoutStorage)
+
+typedef struct Compiler *myCompiler;
+struct Compiler {
+    //source
+    myScanner scanner;              // source of the program, owns the string table
+    myStringTable symbols;          // identifiers of the program (scanner->symbols)
+    //parser (parser.c and llParser.c)
+    myTokenStream tokens;           // tokens of the program, scanned on demand
+    long position;                  // position of the current token in the stream
+    myLexeme t;                     // current token, note that t has {type, len, line, offset, value}, see lexemeText
+    int kind;                       // kind of the current token (see lexemeKind), every parsing decision is made on it
+    int previousKind;               // parser.c : kind of the token matched before the current one
+    int pending;                    // llParser : 1 once the current token is matched, the next one is not read yet
+    char tokenText[25];             // text of the current token, for the tree nodes
+    int errors;                     // scanner, syntax and scope errors found so far (see reportError)
+    int panic;                      // parser.c : 1 from a syntax error until the parser is back in step, no syntax error is reported meanwhile
+    long lastPosition;              // parser.c : last token the parser may read, the next ones read as EOF; -1 for none
+    struct ParseJobs *jobs;         // parallelParser.c : blocks left to the threads, NULL when parsing serially
+    //tree (buildTree.c)
+    struct BSTNode *tree;           // root of the parsed tree, NULL until the parser builds it
+    myArena arena;                  // every node and child array of the tree, freed at once
+    int labels;                     // nodes created so far (see BSTNode.label)
+    int line;                       // source line given to the nodes built from now on
+    int staleDepths;                // 1 once adoptTree moved a subtree one level down
+    //scope checker (scopeCheck.c), a pass over the parsed tree
+    myScopeTable scopes;            // variables declared in the open scopes
+    //storage (storage.c)
+    int slots;                      // slots of the data section, 0 when the variables are stored under their names
+    //code generator (traversals.c)
+    myTextBuffer footer;            // ASM lines written after STOP (variables and temporaries)
+    int slotsDeclared;              // slots written to the footer so far
+    //outputs, the files named by the caller (or stdout and stderr) are used when NULL
+    myTextBuffer treeOut;           // tree dump (TravPreOrder)
+    myTextBuffer asmOut;            // ASM program (generateASM)
+    myTextBuffer diagnostics;       // messages of the parser and the scope checks (see diagnose)
+};
+
+//what compileSource gives back, each text is either set by the caller
+//(e.g. useTextBuffer over its own memory) or left NULL to get a new one;
+//threads is set by the caller too
+struct CompileResult {
+    myTextBuffer asmText;           // ASM program, the text of the .asm file
+    myTextBuffer treeText;          // tree dump, the text of the .tree file
+    myTextBuffer diagnostics;       // scanner, parser and scope messages, in the order they were found
+    int threads;                    // threads the scanner, parallelDescent and the scope checks may use (see useThreads), 0 or 1 for none
+    int errors;                     // scanner, syntax and scope errors found (see reportError), 0 for a correct program
+};
+
+
+/*****************
+ * Function:
+ *      newCompiler
+ * Description:
+ *      Create the context of one compilation
+ * Input:
+ *      the scanner ADT of the program (kept by the caller, see clearCompiler)
+ * Output:
+ *      a compilation context ADT, NULL if there is no scanner
+ *****************/
+myCompiler newCompiler(myScanner scanIt);
+
+
+/*****************
+ * Function:
+ *      clearCompiler
+ * Description:
+ *      free up memory used by a compilation context, its tree included.
+ *      The scanner is left to the caller: it is cleared after the context,
+ *      since the names of the symbols belong to it
+ * Input:
+ *      a compilation context ADT (may be NULL)
+ * Output:
+ *      released memory previously occupied by the context
+ *****************/
+void clearCompiler(myCompiler c);
+
+
+/*****************
+ * Function:
+ *      diagnose
+ * Description:
+ *      Report a message of the compilation, as fprintf would: in the
+ *      diagnostics of the context when it has them, on the stream otherwise
+ * Input:
+ *      a compilation context ADT, the stream used without diagnostics
+ *      (stderr or stdout), a format and its arguments
+ * Output:
+ *      none
+ *****************/
+void diagnose(myCompiler c, FILE *stream, const char *format, ...);
+
+
+/*****************
+ * Function:
+ *      reportError
+ * Description:
+ *      Report an error of the program, as diagnose would, and count it.
+ *      Once errorCap errors are counted the next ones are dropped: the
+ *      parsers stop there (a last message tells so)
+ * Input:
+ *      a compilation context ADT, the stream used without diagnostics,
+ *      a format and its arguments; a NULL format counts an error already
+ *      reported (by the scanner)
+ * Output:
+ *      none
+ *****************/
+void reportError(myCompiler c, FILE *stream, const char *format, ...);
+
+
+/*****************
+ * Function:
+ *      reportErrorList
+ * Description:
+ *      Same as reportError, with the arguments in a va_list (as vfprintf)
+ * Input:
+ *      a compilation context ADT, the stream used without diagnostics,
+ *      a format and its arguments
+ * Output:
+ *      none
+ *****************/
+void reportErrorList(myCompiler c, FILE *stream, const char *format, va_list args);
+
+
+/*****************
+ * Function:
+ *      compileSource
+ * Description:
+ *      Compile a program held in memory, without any file: the ASM, the
+ *      tree dump and the messages are the texts the command line compiler
+ *      writes to the .asm file, the .tree file and the terminal. The
+ *      texts of the result are emptied first. Safe to call from several
+ *      threads at once, with one result each.
+ * Input:
+ *      the source (not necessarily null terminated), its length in bytes,
+ *      the parser engine (descentParser, tableParser or parallelDescent,
+ *      which parses serially unless result->threads allows threads, see
+ *      useThreads), or'ed with trustedSource to skip the scope checks
+ *      with sharedExpressions to share identical expressions and with
+ *      scopedStorage to overlay the variables of sibling blocks, and the
+ *      result, whose NULL texts are created
+ * Output:
+ *      1 if a tree was built and written, 0 otherwise; the texts and the
+ *      number of errors in the result (a tree may be built with errors)
+ *****************/
+int compileSource(const char *src, long len, int engine, struct CompileResult *result);
+
+
+/*****************
+ * Function:
+ *      clearCompileResult
+ * Description:
+ *      free up the texts of a result (the caller's memory is left alone)
+ *      and set them back to NULL
+ * Input:
+ *      a result given to compileSource
+ * Output:
+ *      released memory previously occupied by the texts
+ *****************/
+void clearCompileResult(struct CompileResult *result);
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ ============================================================================
+ Name        : exprDag.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the hash-consed expressions declared in exprDag.h
+ Functions	 : int shareable (Treeptr node)
+                unsigned long hashNode (Treeptr node, Treeptr *kids)
+                Treeptr findNode (struct DagTable *t, Treeptr node, Treeptr *kids)
+                void addNode (struct DagTable *t, Treeptr node)
+                Treeptr copyNode (myArena arena, Treeptr node, Treeptr *kids)
+                void copyExit (void *state, Treeptr node, int level)
+                long shareTree (myCompiler c)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./exprDag.h"
+#include "./visitor.h"
+
+//the shared expressions, open addressing on the hash of their key
+struct DagTable {
+    Treeptr *slots;                 // NULL for a free slot
+    long room;
+    long count;
+};
+
+
+//1 if a node of the parsed tree is part of an expression
+static int shareable (Treeptr node) {
+    Treeptr parent = node->parent;
+    if (parent == NULL) return 0;
+    if (strcmp(node->data, "<expr>") != 0 && strcmp(node->data, "<neg>") != 0
+            && strcmp(node->data, "<ID>") != 0 && strcmp(node->data, "<INT>") != 0) return 0;
+    if (strcmp(parent->data, "<expr>") == 0 || strcmp(parent->data, "<neg>") == 0
+            || strcmp(parent->data, "<RO>") == 0 || strcmp(parent->data, "<Out>") == 0) return 1;
+    return strcmp(parent->data, "<assign>") == 0 && parent->children[0] != node;   // not the variable assigned
+}
+
+//hash of the key of a node: name, value, symbol, slot and the IDs of its (shared) children
+static unsigned long hashNode (Treeptr node, Treeptr *kids) {
+    unsigned long h = 2166136261UL;
+    const char *s;
+    int i;
+    for (s = node->data; *s != '\0'; s++) h = (h ^ (unsigned char)*s) * 16777619UL;
+    for (s = node->value; *s != '\0'; s++) h = (h ^ (unsigned char)*s) * 16777619UL;
+    h = (h ^ (unsigned long)node->symbol) * 16777619UL;
+    h = (h ^ (unsigned long)node->slot) * 16777619UL;
+    for (i = 0; i<node->nChildren; i++) h = (h ^ (unsigned long)kids[i]->label) * 16777619UL;
+    return h;
+}
+
+//the shared node with the key of a node whose children are kids, NULL if none
+static Treeptr findNode (struct DagTable *t, Treeptr node, Treeptr *kids) {
+    Treeptr other;
+    long slot = hashNode(node, kids) & (t->room - 1);
+    int i;
+    for (; (other = t->slots[slot]) != NULL; slot = (slot + 1) & (t->room - 1)) {
+        if (other->symbol != node->symbol || other->slot != node->slot || other->nChildren != node->nChildren
+                || strcmp(other->data, node->data) != 0 || strcmp(other->value, node->value) != 0) continue;
+        for (i = 0; i<node->nChildren && other->children[i] == kids[i]; i++);
+        if (i == node->nChildren) return other;
+    }
+    return NULL;
+}
+
+//share a node from now on, the table doubles when half full
+static void addNode (struct DagTable *t, Treeptr node) {
+    Treeptr *slots = t->slots;
+    long room = t->room, i, slot;
+    if (2 * (t->count + 1) > t->room) {
+        t->room *= 2;
+        t->slots = calloc(t->room, sizeof(Treeptr));
+        for (i = 0; i<room; i++) {
+            if (slots[i] == NULL) continue;
+            for (slot = hashNode(slots[i], slots[i]->children) & (t->room - 1); t->slots[slot] != NULL; slot = (slot + 1) & (t->room - 1));
+            t->slots[slot] = slots[i];
+        }
+        free(slots);
+    }
+    for (slot = hashNode(node, node->children) & (t->room - 1); t->slots[slot] != NULL; slot = (slot + 1) & (t->room - 1));
+    t->slots[slot] = node;
+    t->count++;
+}
+
+//a copy of a node in an arena, with the children given; the children new to
+//the DAG get it as their parent
+static Treeptr copyNode (myArena arena, Treeptr node, Treeptr *kids) {
+    Treeptr copy = arenaAlloc(arena, sizeof(struct BSTNode));
+    int i;
+    *copy = *node;
+    copy->parent = NULL;
+    copy->children = NULL;
+    copy->capChildren = node->nChildren;
+    if (node->nChildren > 0) {
+        copy->children = arenaAlloc(arena, node->nChildren * sizeof(Treeptr));
+        for (i = 0; i<node->nChildren; i++) {
+            copy->children[i] = kids[i];
+            if (kids[i]->parent == NULL) kids[i]->parent = copy;
+        }
+    }
+    return copy;
+}
+
+
+//a copy of a tree being made
+struct DagCopy {
+    struct DagTable t;
+    myArena arena;                  // the arena of the copy
+    Treeptr *done;                  // copies waiting for their parent
+    long nDone, roomDone;
+    long shared;
+};
+
+//copy a node whose children are copied (or found shared), unless it is an
+//expression seen before
+static void copyExit (void *state, Treeptr node, int level) {
+    struct DagCopy *d = state;
+    Treeptr copy;
+    d->nDone -= node->nChildren;                            // its children, copied or shared
+    copy = shareable(node) ? findNode(&d->t, node, d->done + d->nDone) : NULL;
+    if (copy != NULL) d->shared++;
+    else {
+        copy = copyNode(d->arena, node, d->done + d->nDone);
+        if (shareable(node)) addNode(&d->t, copy);
+    }
+    if (d->nDone == d->roomDone) {
+        d->roomDone *= 2;
+        d->done = realloc(d->done, d->roomDone * sizeof(Treeptr));
+    }
+    d->done[d->nDone++] = copy;
+}
+
+
+/*****************
+ * Function:
+ *      shareTree
+ * Description:
+ *      Copy the tree in postorder (see visitor.h) into a new arena: the
+ *      children of a node are copied (or found shared) before it, an
+ *      expression node is then looked up by its key and only copied if it
+ *      is new. The copies waiting for their parent are kept on a stack.
+ *      A node keeps its label, so the ASM names are those of the first use
+ *      of an expression
+ * Input:
+ *      a compilation context ADT, with or without a tree
+ * Output:
+ *      the number of expression nodes left out (shared)
+ *****************/
+long shareTree (myCompiler c) {
+    struct DagCopy d;
+    struct Visitor v = {NULL, NULL, copyExit, NULL};
+
+    if (c->tree == NULL) return 0;
+    d.arena = newArena();
+    d.t.room = dagSlots;
+    d.t.count = 0;
+    d.t.slots = calloc(d.t.room, sizeof(Treeptr));
+    d.roomDone = 256;
+    d.nDone = 0;
+    d.done = malloc(d.roomDone * sizeof(Treeptr));
+    d.shared = 0;
+    v.state = &d;
+    visitTree(c->tree, 0, &v);
+    c->tree = d.done[0];
+    clearArena(c->arena);
+    c->arena = d.arena;
+
+    free(d.done);
+    free(d.t.slots);
+    return d.shared;
+}
@@ -0,0 +1,51 @@
+/*
+ ============================================================================
+ Name        : exprDag.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Hash-consed expressions. The parsed tree is copied into a new
+                arena, and every expression subtree (<expr>, <neg>, <ID> and
+                <INT> nodes on the right of an <assign>, in an <Out> or in
+                an <RO>) is stored once: a node is keyed on its name, its
+                value, its storage slot (see storage.h) and the IDs (labels)
+                of its children, themselves already shared, so a subtree
+                seen before is referenced, not copied. The tree becomes a DAG whose shared nodes have
+                several parents, their parent field being the first one.
+                Expressions have no side effect, so the tree dump and the
+                ASM read the shared form as they read the tree: the dump is
+                the same text, the ASM computes a shared expression each
+                time it is used, with one temporary.
+                The scopes are checked before (a shared <ID> keeps the line
+                of its first use only), see sharedExpressions in compiler.h.
+
+ ============================================================================
+ */
+
+#ifndef _EXPRDAG_H_
+#define _EXPRDAG_H_
+
+#include "./compiler.h"
+#include "./buildTree.h"
+
+//configuration : initial room of the table of shared expressions, doubled when half full
+#define dagSlots (1024)
+
+
+/*****************
+ * Function:
+ *      shareTree
+ * Description:
+ *      Make the tree of a compilation a DAG sharing its identical
+ *      expressions. The nodes are moved to a new arena, the old one is
+ *      freed, so the nodes left out give their memory back
+ * Input:
+ *      a compilation context ADT, with or without a tree
+ * Output:
+ *      the number of expression nodes left out (shared), c->tree and
+ *      c->arena replaced
+ *****************/
+long shareTree (myCompiler c);
+
+#endif
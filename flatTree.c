@@ -0,0 +1,240 @@
+/*
+ ============================================================================
+ Name        : flatTree.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the flattened tree layout declared in flatTree.h
+ Functions	 : int nodeKind (const char *data)
+                int operatorKind (const char *text)
+                const char *operatorText (int kind)
+                int countEnter (void *state, Treeptr node, int level)
+                int fillEnter (void *state, Treeptr node, int level)
+                myFlatTree flattenTree(myCompiler c)
+                void flatTreeDump(myFlatTree ft, FILE *out)
+                void clearFlatTree(myFlatTree ft)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./flatTree.h"
+#include "./token.h"
+#include "./stringTable.h"
+#include "./visitor.h"
+
+//node names, indexed by node kind
+static const char *flatNames[flatKinds] = {
+    "", "<program>", "<vars>", "<block>", "<Stats>", "<stat>", "<In>", "<Out>", "<If>", "<Loop>",
+    "<assign>", "<expr>", "<neg>", "<RO>", "<ID>", "<INT>"
+};
+
+//operators a node value can hold, and their token kinds
+static const struct { const char *text; int kind; } operators[] = {
+    { "=", equalOperator }, { "<", lessOperator }, { ">", greaterOperator },
+    { "=!=", notEqualOperator }, { ">=>", greaterEqualOperator }, { "<=<", lessEqualOperator },
+    { "==", assignOperator }, { "+", plusOperator }, { "-", minusOperator },
+    { "*", timesOperator }, { "/", divideOperator }
+};
+#define nOperators ((int) (sizeof(operators) / sizeof(operators[0])))
+
+
+/*****************
+ * Function:
+ *      nodeKind
+ * Description:
+ *      This function is internal to the ADT.
+ *      Find the kind of a node from its name
+ * Input:
+ *      the name of a node (BSTNode.data)
+ * Output:
+ *      a node kind, flatUnknown if the name is not known
+ *****************/
+static int nodeKind (const char *data) {
+    int k;
+    for (k = 1; k<flatKinds; k++) if (strcmp(data, flatNames[k]) == 0) return k;
+    return flatUnknown;
+}
+
+
+/*****************
+ * Function:
+ *      operatorKind
+ * Description:
+ *      This function is internal to the ADT.
+ *      Find the token kind of an operator
+ * Input:
+ *      the text of an operator (BSTNode.value)
+ * Output:
+ *      a token kind, flatNone if the text is not an operator
+ *****************/
+static int operatorKind (const char *text) {
+    int k;
+    for (k = 0; k<nOperators; k++) if (strcmp(text, operators[k].text) == 0) return operators[k].kind;
+    return flatNone;
+}
+
+
+/*****************
+ * Function:
+ *      operatorText
+ * Description:
+ *      This function is internal to the ADT.
+ *      Give the text of an operator
+ * Input:
+ *      a token kind
+ * Output:
+ *      the text of the operator, "" if the kind is not an operator
+ *****************/
+static const char *operatorText (int kind) {
+    int k;
+    for (k = 0; k<nOperators; k++) if (operators[k].kind == kind) return operators[k].text;
+    return "";
+}
+
+
+//a flat tree being filled
+struct FlatFill {
+    myFlatTree ft;
+    int next;                       // index of the next node
+    int *last;                      // index of the last node stored at each level, flatNone before the first
+    int room;
+};
+
+//count a node
+static int countEnter (void *state, Treeptr node, int level) {
+    (*(int *)state)++;
+    return 1;
+}
+
+
+/*****************
+ * Function:
+ *      fillEnter
+ * Description:
+ *      This function is internal to the ADT.
+ *      Store a node at the next index (the nodes are reached in preorder,
+ *      see visitor.h): its first child comes right after it, it is the
+ *      next sibling of the last node stored at its level since its parent
+ * Input:
+ *      the flat tree being filled, a node and its level
+ * Output:
+ *      1, its children are stored next
+ *****************/
+static int fillEnter (void *state, Treeptr node, int level) {
+    struct FlatFill *f = state;
+    myFlatTree ft = f->ft;
+    int i = f->next++;
+
+    if (level + 2 > f->room) {
+        while (level + 2 > f->room) f->room *= 2;
+        f->last = realloc(f->last, f->room * sizeof(int));
+    }
+    ft->kind[i] = nodeKind(node->data);
+    if (ft->kind[i] == flatId) ft->value[i] = node->symbol;
+    else if (ft->kind[i] == flatInt) ft->value[i] = internSymbol(ft->symbols, node->value, strlen(node->value));
+    else ft->value[i] = operatorKind(node->value);
+    ft->line[i] = node->line;
+    ft->depth[i] = node->count;
+    ft->child[i] = (node->nChildren > 0) ? i + 1 : flatNone;
+    ft->sibling[i] = flatNone;
+
+    if (f->last[level] != flatNone) ft->sibling[f->last[level]] = i;
+    f->last[level] = i;
+    f->last[level + 1] = flatNone;                      // its children have no sibling yet
+    return 1;
+}
+
+
+/*****************
+ * Function:
+ *      flattenTree
+ * Description:
+ *      Convert the tree of a compilation into the flat layout
+ * Input:
+ *      a compilation context ADT (its tree may be NULL)
+ * Output:
+ *      a flat tree ADT
+ *****************/
+myFlatTree flattenTree(myCompiler c) {
+    myFlatTree ft = malloc(sizeof(struct FlatTree));
+    Treeptr root = c->tree;
+    struct Visitor count = {countEnter, NULL, NULL, NULL}, fill = {fillEnter, NULL, NULL, NULL};
+    struct FlatFill f;
+    int n = 0;
+
+    count.state = &n;
+    visitTree(root, 0, &count);
+
+    ft->count = n;
+    ft->symbols = c->symbols;
+    ft->kind = malloc(n + 1);
+    ft->child = malloc((n + 1) * sizeof(int));
+    ft->sibling = malloc((n + 1) * sizeof(int));
+    ft->value = malloc((n + 1) * sizeof(int));
+    ft->line = malloc((n + 1) * sizeof(int));
+    ft->depth = malloc((n + 1) * sizeof(int));
+    f.ft = ft;
+    f.next = 0;
+    f.room = 64;
+    f.last = malloc(f.room * sizeof(int));
+    f.last[0] = flatNone;
+    fill.state = &f;
+    visitTree(root, 0, &fill);
+    free(f.last);
+    return ft;
+}
+
+
+/*****************
+ * Function:
+ *      flatTreeDump
+ * Description:
+ *      Write the tree dump of a flat tree with one linear scan: each node
+ *      is indented by its depth, then its name and value are written
+ * Input:
+ *      a flat tree ADT and an open stream
+ * Output:
+ *      the dump on the stream
+ *****************/
+void flatTreeDump(myFlatTree ft, FILE *out) {
+    static const char spaces[] = "                                                                ";
+    int i, d;
+    for (i = 0; i<ft->count; i++) {
+        const char *value;
+        for (d = ft->depth[i] * 2; d > 0; d -= sizeof(spaces) - 1) {
+            fwrite(spaces, 1, (d < (int) sizeof(spaces) - 1) ? d : (int) sizeof(spaces) - 1, out);
+        }
+        switch (ft->kind[i]) {
+            case flatId:
+            case flatInt: value = symbolName(ft->symbols, ft->value[i]); break;
+            default: value = operatorText(ft->value[i]); break;
+        }
+        fprintf(out, "%s %s \n", flatNames[ft->kind[i]], value);
+    }
+}
+
+
+/*****************
+ * Function:
+ *      clearFlatTree
+ * Description:
+ *      free up memory used by a flat tree ADT
+ * Input:
+ *      a flat tree ADT
+ * Output:
+ *      released memory previously occupied by the flat tree ADT
+ *****************/
+void clearFlatTree(myFlatTree ft) {
+    if (ft == NULL) return;
+    free(ft->kind);
+    free(ft->child);
+    free(ft->sibling);
+    free(ft->value);
+    free(ft->line);
+    free(ft->depth);
+    free(ft);
+}
@@ -0,0 +1,103 @@
+/*
+ ============================================================================
+ Name        : flatTree.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Flattened layout of the parsed tree. The nodes are stored in
+                preorder, one array per field: node kind, first child and next
+                sibling (32-bit indices), symbol/literal ID or operator kind,
+                source line and depth. A node's first child is the node right
+                after it, and a subtree is one contiguous range, so passes
+                such as the tree dump run as one linear scan over a few small
+                arrays instead of chasing pointers from node to node.
+                A flat tree is converted from a Treeptr tree (flattenTree);
+                both layouts can be compared with "make benchtree".
+
+ ============================================================================
+ */
+
+#ifndef _FLATTREE_H_
+#define _FLATTREE_H_
+
+#include <stdio.h>
+#include "./buildTree.h"
+
+//configuration : node kinds, one per node name of the parser
+#define flatUnknown (0)
+#define flatProgram (1)                 // <program>
+#define flatVars (2)                    // <vars>
+#define flatBlock (3)                   // <block>
+#define flatStats (4)                   // <Stats>
+#define flatStat (5)                    // <stat>
+#define flatIn (6)                      // <In>
+#define flatOut (7)                     // <Out>
+#define flatIf (8)                      // <If>
+#define flatLoop (9)                    // <Loop>
+#define flatAssign (10)                 // <assign>
+#define flatExpr (11)                   // <expr>, a binary operator
+#define flatNeg (12)                    // <neg>, a unary minus
+#define flatRO (13)                     // <RO>
+#define flatId (14)                     // <ID>
+#define flatInt (15)                    // <INT>
+#define flatKinds (16)
+
+#define flatNone (-1)                   // no child, no sibling, no value
+
+typedef struct FlatTree *myFlatTree;
+struct FlatTree {
+    int count;                      // number of nodes, node 0 is the root
+    unsigned char *kind;            // node kind (see above)
+    int *child;                     // index of the first child (always the next node), flatNone for a leaf
+    int *sibling;                   // index of the next sibling, flatNone for the last child
+    int *value;                     // symbol ID of identifiers and integers (see stringTable.h),
+                                    // token kind of operators (see token.h), flatNone otherwise
+    int *line;                      // source line
+    int *depth;                     // depth, 1 for the root (see BSTNode.count)
+    myStringTable symbols;          // names of the IDs in value, the ones of the compilation
+};
+
+
+/*****************
+ * Function:
+ *      flattenTree
+ * Description:
+ *      Convert the tree of a compilation into the flat layout. Integer
+ *      literals are interned in its string table, so their text is kept as
+ *      it was written.
+ * Input:
+ *      a compilation context ADT (its tree may be NULL)
+ * Output:
+ *      a flat tree ADT
+ *****************/
+myFlatTree flattenTree(myCompiler c);
+
+
+/*****************
+ * Function:
+ *      flatTreeDump
+ * Description:
+ *      Write the tree dump of a flat tree (the same text as TravPreOrder)
+ *      with one linear scan
+ * Input:
+ *      a flat tree ADT and an open stream
+ * Output:
+ *      the dump on the stream
+ *****************/
+void flatTreeDump(myFlatTree ft, FILE *out);
+
+
+/*****************
+ * Function:
+ *      clearFlatTree
+ * Description:
+ *      free up memory used by a flat tree ADT
+ * Input:
+ *      a flat tree ADT
+ * Output:
+ *      released memory previously occupied by the flat tree ADT
+ *****************/
+void clearFlatTree(myFlatTree ft);
+
+#endif
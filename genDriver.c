@@ -0,0 +1,522 @@
+/*
+ ============================================================================
+ Name        : genDriver.c
+ Author      : NGUYEN, TAM N
+ Created on  : 15OCT16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Build time generator of the scanner driver table.
+                The automaton (see README.md) is laid out here once, the same
+                way it used to be hard coded in initScanner, then compacted:
+                 - each byte is mapped to a character class (256 entries)
+                 - character classes with identical columns are merged
+                 - equivalent states are merged (minimized automaton)
+                The result is written to stdout as a C header holding read-only
+                tables shared by every scanner (see driverTable.h).
+                Run as "genDriver direct", it writes the same minimized automaton
+                as direct code instead (see driverDirect.h): each state is a block
+                of code and each transition a goto, so the scanner's inner loop
+                does not load its next state from a table.
+                The reserved words get a perfect hash, written to driverTable.h
+                with the driver: every keyword lands in its own slot, so a
+                token is classified with one hash and one exact compare.
+ Functions	 : void buildAutomaton ()
+                int mapCharacter (int c)
+                void compactColumns ()
+                void minimizeStates ()
+                int runKind (int state)
+                int keywordSlot (const char *word, int a, int b)
+                void findKeywordHash ()
+                void emitTables ()
+                void emitCharacter (int c)
+                void emitDirect ()
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./token.h"
+
+#define maxStates (16)                  // 16 rows - 16 states
+#define maxColumns (25)                 // 24 sets of values + 1 for characters outside the alphabet
+#define finalBase (64)                  // table entries >= finalBase hold (code - 980 + finalBase)
+
+//kinds of runs a state can consume at once (see simdScan.h)
+#define runNone (0)
+#define runBlank (1)                    // ' ' and new lines keep the state
+#define runAlnum (2)                    // letters and digits keep the state
+#define runDigit (3)                    // digits keep the state
+static const char *runNames[] = { "driverRunNone", "driverRunBlank", "driverRunAlnum", "driverRunDigit" };
+
+int table[maxStates][maxColumns];       // automaton as specified by the README
+int columnOf[maxColumns];               // original column -> compact class
+int nClasses = 0;
+int classColumn[maxColumns];            // compact class -> representative original column
+int stateOf[maxStates];                 // original state -> minimized state
+int nStates = 0;
+int stateRow[maxStates];                // minimized state -> representative original state
+
+//reserved words and their keyword kinds (see token.h)
+#define keywordSize (32)                // slots of the keyword hash, a power of 2
+static const struct { const char *word; int kind; } keywords[] = {
+    { "Begin", beginKeyword }, { "End", endKeyword }, { "Start", startKeyword },
+    { "Stop", stopKeyword }, { "Iff", iffKeyword }, { "Loop", loopKeyword },
+    { "Void", voidKeyword }, { "Var", varKeyword }, { "Int", intKeyword },
+    { "Call", callKeyword }, { "Return", returnKeyword }, { "Scan", scanKeyword },
+    { "Print", printKeyword }, { "Program", programKeyword }
+};
+#define nKeywords ((int) (sizeof(keywords) / sizeof(keywords[0])))
+int hashFirst = 0;                      // weight of the first character
+int hashLast = 0;                       // weight of the last character
+int keywordAt[keywordSize];             // slot -> index in keywords, -1 when empty
+
+
+/*****************
+ * Function:
+ *      buildAutomaton
+ * Description:
+ *      Populate the driver table with the automaton values.
+ *      Please refer to README.md for details regarding
+ *      automaton and mapped driver table.
+ * Input:
+ *      none
+ * Output:
+ *      the global table filled with state and token codes
+ *****************/
+void buildAutomaton () {
+    //step 1 - filling table with ERROR code "980"
+    int i,j;
+    for (i = 0; i<16; i++){                             // 16 rows - 16 states
+        for (j = 0; j<24; j++) {                        // 24 columns - 24 sets of values
+            table[i][j] = invalidToken_errorCode;
+        }
+    }
+    //step 2 - filling in TOKEN codes (defined in token.h file)
+    for (i=2; i<24; i++) table[1][i] = idCode;          //991 : Identifier Token
+    for (i = 0; i<16; i++){
+        for (j = 0; j<24; j++) {
+            //Fill the "Relational" token code
+            if (i==2 || i==4 || i==5 || i==7 || i==8 || i==10 ){
+                if (j==0 || j==1 || j==2 || (j>=8 && j<=13) ||j==15 ||j==18 ||j==21 ){
+                    table[i][j] = relCode;              //992 : Relational Token
+                }
+            }
+            //Fill the "Other" token code
+            if (i==11){
+                if (j==0 || j==1 || j==2 ||(j>=8 && j<=13) ||j==15 ||j==18 ||j==21 ){
+                    table[i][j] = otherCode;            //993 : Other Token
+                }
+            }
+            if (i==12){
+                if (j==0 || j==1 || j==2 || j==15 ||j==18 ||j==21 ){
+                    table[i][j] = otherCode;            //993 : Other Token
+                }
+            }
+            //Fill the "Delimiter" token code
+            if (i==13){
+                if (j==0 || j==1 || j==2 || (j>=8 && j<=13)) {
+                    table[i][j] = delimCode;            //994 : Delimiter Token
+                }
+            }
+            //Fill the "Integer" token code
+            if (i==14){
+                if ((j>=2 && j<=5) || (j>=8 && j<=13) || (j>=15 && j<=22)) {
+                    table[i][j] = intCode;              //995 : Integer Token
+                }
+            }
+            //Fill in the "Comment" token code
+            table[15][2] = comCode;                     //996 : Comment token
+        }
+        table[i][24] = invalidCharacter_errorCode;      // fill col 24 with invalidCharacter_errorCode
+    }
+
+    //step 3 - filling in STATE codes (in asscending state code order)
+    table[0][2] = 0;
+    table[0][0] = table[1][0] = table[1][1] = 1;
+    table[0][3] = 2;
+    table[2][6] = 3;
+    table[3][3] = 4;
+    table[0][4] = 5;
+    table[5][3] = 6;
+    table[6][4] = 7;
+    table[0][5] = 8;
+    table[8][3] = 9;
+    table[9][5] = 10;
+    table[2][3] = 11;
+    for (i = 7; i<14; i++) table[0][i] = 12;
+    for (i = 14; i<23; i++) table[0][i] = 13;
+    table[0][1] = table[14][1] = 14;
+    table[0][23] = table[15][0] = table[15][1] = 15;
+    for (i = 3; i<24; i++) table[15][i] = 15;
+}
+
+
+/*****************
+ * Function:
+ *      mapCharacter
+ * Description:
+ *      Translate a character (its ascii value) to its column
+ *      in the mapped automaton table
+ * Input:
+ *      a byte value, 0 to 255
+ * Output:
+ *      the column of that character in the driver table
+ *****************/
+int mapCharacter (int c) {
+    if ((c>=65 && c<=90) || (c>=97 && c<=122)) return 0;   //map to col 0 in mapped automaton table
+    if (c>=48 && c<=57) return 1;
+    switch (c) {
+        case 32:  return 2;
+        case 61:  return 3;
+        case 60:  return 4;
+        case 62:  return 5;
+        case 33:  return 6;
+        case 58:  return 7;
+        case 43:  return 8;
+        case 45:  return 9;
+        case 42:  return 10;
+        case 47:  return 11;
+        case 38:  return 12;
+        case 37:  return 13;
+        case 46:  return 14;
+        case 40:  return 15;
+        case 41:  return 16;
+        case 44:  return 17;
+        case 123: return 18;
+        case 125: return 19;
+        case 59:  return 20;
+        case 91:  return 21;
+        case 93:  return 22;
+        case 64:  return 23;
+        default:  return 24;
+    }
+}
+
+
+/*****************
+ * Function:
+ *      compactColumns
+ * Description:
+ *      Merge the columns (sets of characters) that behave the same
+ *      in every state into one character class
+ * Input:
+ *      none
+ * Output:
+ *      columnOf, classColumn and nClasses populated
+ *****************/
+void compactColumns () {
+    int i,j,k;
+    for (j = 0; j<maxColumns; j++) {
+        for (k = 0; k<nClasses; k++) {
+            for (i = 0; i<maxStates; i++) {
+                if (table[i][j] != table[i][classColumn[k]]) break;
+            }
+            if (i == maxStates) break;                  // same column found
+        }
+        if (k == nClasses) classColumn[nClasses++] = j;
+        columnOf[j] = k;
+    }
+}
+
+
+/*****************
+ * Function:
+ *      minimizeStates
+ * Description:
+ *      Merge equivalent states. Two states are equivalent when, for every
+ *      character class, they either produce the same token/error code or
+ *      move to equivalent states. The partition is refined until it is
+ *      stable. The start state always keeps number 0.
+ * Input:
+ *      none
+ * Output:
+ *      stateOf, stateRow and nStates populated
+ *****************/
+void minimizeStates () {
+    int group[maxStates], next[maxStates];
+    int i,j,k,changed = 1;
+    int count = 1;
+    for (i = 0; i<maxStates; i++) group[i] = 0;
+
+    while (changed) {
+        int reps[maxStates], nReps = 0;
+        for (i = 0; i<maxStates; i++) {
+            for (k = 0; k<nReps; k++) {
+                int r = reps[k];
+                if (group[r] != group[i]) continue;
+                for (j = 0; j<nClasses; j++) {
+                    int a = table[i][classColumn[j]], b = table[r][classColumn[j]];
+                    if (a >= invalidToken_errorCode || b >= invalidToken_errorCode) {
+                        if (a != b) break;
+                    } else if (group[a] != group[b]) break;
+                }
+                if (j == nClasses) break;               // same behavior as reps[k]
+            }
+            if (k == nReps) reps[nReps++] = i;
+            next[i] = k;
+        }
+        changed = (nReps != count);
+        count = nReps;
+        for (i = 0; i<maxStates; i++) group[i] = next[i];
+        for (k = 0; k<nReps; k++) stateRow[k] = reps[k];
+    }
+    nStates = count;
+    for (i = 0; i<maxStates; i++) stateOf[i] = group[i];
+}
+
+
+/*****************
+ * Function:
+ *      runKind
+ * Description:
+ *      Find which run of characters keeps a (minimized) state unchanged,
+ *      so the scanner can consume the whole run in one step
+ * Input:
+ *      a minimized state
+ * Output:
+ *      runBlank, runAlnum, runDigit or runNone
+ *****************/
+int runKind (int state) {
+    int c, letters = 1, digits = 1;
+    int *row = table[stateRow[state]];
+    if (row[mapCharacter(' ')] < invalidToken_errorCode && stateOf[row[mapCharacter(' ')]] == state) return runBlank;
+    for (c = 0; c<256; c++) {
+        int v = row[mapCharacter(c)];
+        int same = v < invalidToken_errorCode && stateOf[v] == state;
+        if (c >= '0' && c <= '9') digits = digits && same;
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) letters = letters && same;
+    }
+    if (letters && digits) return runAlnum;
+    if (digits) return runDigit;
+    return runNone;
+}
+
+
+/*****************
+ * Function:
+ *      keywordSlot
+ * Description:
+ *      Hash a word from its first character, last character and length.
+ *      Must stay in line with the keywordHash macro written to driverTable.h
+ * Input:
+ *      a word and the weights of its first and last characters
+ * Output:
+ *      a slot, 0 to keywordSize - 1
+ *****************/
+int keywordSlot (const char *word, int a, int b) {
+    int n = strlen(word);
+    return ((unsigned char) word[0] * a + (unsigned char) word[n - 1] * b + n) & (keywordSize - 1);
+}
+
+
+/*****************
+ * Function:
+ *      findKeywordHash
+ * Description:
+ *      Search the smallest weights for which every reserved word
+ *      lands in a slot of its own (a perfect hash)
+ * Input:
+ *      none
+ * Output:
+ *      hashFirst, hashLast and keywordAt populated,
+ *      the program stops when no such weights exist
+ *****************/
+void findKeywordHash () {
+    int a,b,i;
+    for (a = 1; a<keywordSize * 2; a++) {
+        for (b = 0; b<keywordSize * 2; b++) {
+            for (i = 0; i<keywordSize; i++) keywordAt[i] = -1;
+            for (i = 0; i<nKeywords; i++) {
+                int slot = keywordSlot(keywords[i].word, a, b);
+                if (keywordAt[slot] != -1) break;       // collision
+                keywordAt[slot] = i;
+            }
+            if (i == nKeywords) {
+                hashFirst = a;
+                hashLast = b;
+                return;
+            }
+        }
+    }
+    fprintf(stderr, "ERROR : no perfect hash for the reserved words in %d slots. \n", keywordSize);
+    exit(EXIT_FAILURE);
+}
+
+
+/*****************
+ * Function:
+ *      emitTables
+ * Description:
+ *      Write the compact, read-only driver tables as a C header
+ * Input:
+ *      none
+ * Output:
+ *      driverTable.h content printed to stdout
+ *****************/
+void emitTables () {
+    int i,j;
+    int maxLen = 0;
+    printf("/*\n * driverTable.h - generated by genDriver at build time, do not edit.\n");
+    printf(" * %d states x %d character classes (automaton: %d x %d)\n */\n\n", nStates, nClasses, maxStates, maxColumns);
+    printf("#ifndef _DRIVERTABLE_H_\n#define _DRIVERTABLE_H_\n\n");
+    printf("#define driverStates (%d)\n", nStates);
+    printf("#define driverClasses (%d)\n", nClasses);
+    printf("#define driverFinal (%d)                  // entries >= driverFinal are token/error codes\n", finalBase);
+    printf("#define driverCode(v) ((v) - driverFinal + %d)\n\n", invalidToken_errorCode);
+    printf("#define driverRunNone (%d)\n#define driverRunBlank (%d)\n", runNone, runBlank);
+    printf("#define driverRunAlnum (%d)\n#define driverRunDigit (%d)\n\n", runAlnum, runDigit);
+
+    printf("//byte -> character class\n");
+    printf("static const unsigned char charClass[256] = {");
+    for (i = 0; i<256; i++) {
+        if (i % 16 == 0) printf("\n    ");
+        printf("%2d,", columnOf[mapCharacter(i)]);
+    }
+    printf("\n};\n\n");
+
+    printf("//state x character class -> next state, or driverFinal + (code - %d)\n", invalidToken_errorCode);
+    printf("static const unsigned char driverTable[driverStates][driverClasses] = {");
+    for (i = 0; i<nStates; i++) {
+        printf("\n    {");
+        for (j = 0; j<nClasses; j++) {
+            int v = table[stateRow[i]][classColumn[j]];
+            if (v >= invalidToken_errorCode) v = v - invalidToken_errorCode + finalBase;
+            else v = stateOf[v];
+            printf("%3d,", v);
+        }
+        printf(" },");
+    }
+    printf("\n};\n\n");
+
+    printf("//state -> run of characters the state consumes at once\n");
+    printf("static const unsigned char driverRun[driverStates] = {");
+    for (i = 0; i<nStates; i++) printf(" %d,", runKind(i));
+    printf(" };\n\n");
+
+    printf("//reserved word -> slot, a perfect hash over the %d keywords\n", nKeywords);
+    printf("#define keywordSlots (%d)\n", keywordSize);
+    for (i = 0; i<nKeywords; i++) if ((int) strlen(keywords[i].word) > maxLen) maxLen = strlen(keywords[i].word);
+    printf("#define keywordMaxLen (%d)\n", maxLen);
+    printf("#define keywordHash(w, n) (((unsigned char) (w)[0] * %d + (unsigned char) (w)[(n) - 1] * %d + (n)) & (keywordSlots - 1))\n\n",
+           hashFirst, hashLast);
+    printf("//slot -> reserved word and its keyword kind (noKeyword when empty)\n");
+    printf("static const char keywordText[keywordSlots][keywordMaxLen + 1] = {");
+    for (i = 0; i<keywordSize; i++) {
+        if (i % 8 == 0) printf("\n    ");
+        printf("\"%s\", ", keywordAt[i] < 0 ? "" : keywords[keywordAt[i]].word);
+    }
+    printf("\n};\n");
+    printf("static const unsigned char keywordKind[keywordSlots] = {");
+    for (i = 0; i<keywordSize; i++) printf(" %d,", keywordAt[i] < 0 ? noKeyword : keywords[keywordAt[i]].kind);
+    printf(" };\n\n#endif\n");
+}
+
+
+/*****************
+ * Function:
+ *      emitCharacter
+ * Description:
+ *      Print a byte value as a case label
+ * Input:
+ *      a byte value, 0 to 255
+ * Output:
+ *      "case 'x':" for printable characters, "case n:" otherwise
+ *****************/
+void emitCharacter (int c) {
+    if (c > 32 && c < 127 && c != '\'' && c != '\\') printf("case '%c': ", c);
+    else printf("case %d: ", c);
+}
+
+
+/*****************
+ * Function:
+ *      emitDirect
+ * Description:
+ *      Write the minimized automaton as a direct-coded engine: the function
+ *      getLexemeDirect, where every state is a labeled block switching on the
+ *      current character and every transition jumps to the next block.
+ *      Character handling (new lines, EOF, buffer length, white space) is the
+ *      same as in getLexeme so both engines produce the same tokens.
+ *      The generated code relies on token.c (nextChar, acceptToken,
+ *      rejectToken, finishToken, line counters) and is included there.
+ * Input:
+ *      none
+ * Output:
+ *      driverDirect.h content printed to stdout
+ *****************/
+void emitDirect () {
+    int i,b,k;
+    printf("/*\n * driverDirect.h - generated by genDriver at build time, do not edit.\n");
+    printf(" * Direct-coded scanner engine, %d states. Included by token.c only.\n */\n\n", nStates);
+    printf("#ifndef _DRIVERDIRECT_H_\n#define _DRIVERDIRECT_H_\n\n");
+    printf("//append the current character (white space is skipped), read the next one and jump\n");
+    printf("#define driverShift(next) { if (c != ' ') { buffer[charRead++] = c; } if (eofFlag) { goto finish; } c = nextChar(s); goto next; }\n");
+    printf("//same, consuming the run of characters that keeps the next state first\n");
+    printf("#define driverRunShift(next, kind) { if (c != ' ') { buffer[charRead++] = c; } if (eofFlag) { goto finish; } \\\n");
+    printf("    runAhead(s, kind, buffer, &charRead); c = nextChar(s); goto next; }\n\n");
+    printf("static void getLexemeDirect (myScanner s, myLexeme lx, char *buffer) {\n");
+    printf("    int c;                                  // a byte of the source, or EOF\n    int charRead = 0;\n    int eofFlag = 0;\n    int code;\n\n");
+    printf("    c = nextChar(s);\n\n");
+
+    for (i = 0; i<nStates; i++) {
+        int target[256], counts[256], nTargets = 0, values[256], fallback = 0;
+        //group the bytes by the place they lead to, the largest group is the default
+        for (b = 0; b<256; b++) {
+            int v = table[stateRow[i]][classColumn[columnOf[mapCharacter(b)]]];
+            v = (v >= invalidToken_errorCode) ? v - invalidToken_errorCode + finalBase : stateOf[v];
+            for (k = 0; k<nTargets; k++) if (values[k] == v) break;
+            if (k == nTargets) { values[nTargets] = v; counts[nTargets++] = 0; }
+            counts[k]++;
+            target[b] = k;
+        }
+        for (k = 1; k<nTargets; k++) if (counts[k] > counts[fallback]) fallback = k;
+
+        printf("S%d:\n", i);
+        printf("    if (charRead + 1 > bufLen) goto tooLong;\n");
+        printf("    if (c == '\\n') { s->lineFlag++; c = ' '; }\n");
+        printf("    if (c == EOF) { c = ' '; eofFlag = 1; }\n");
+        printf("    switch ((unsigned char) c) {\n");
+        for (k = 0; k<=nTargets; k++) {
+            int group = (k == nTargets) ? fallback : k;
+            int v = values[group], n = 0;
+            if (k == fallback) continue;
+            if (k == nTargets) printf("        default:\n");
+            else {
+                printf("        ");
+                for (b = 0; b<256; b++) {
+                    if (target[b] != group) continue;
+                    if (n > 0 && n % 8 == 0) printf("\n        ");
+                    emitCharacter(b);
+                    n++;
+                }
+                printf("\n");
+            }
+            if (v < finalBase && runKind(v) != runNone) printf("            driverRunShift(S%d, %s);\n", v, runNames[runKind(v)]);
+            else if (v < finalBase) printf("            driverShift(S%d);\n", v);
+            else if (v - finalBase + invalidToken_errorCode < idCode)
+                printf("            code = %d; goto reject;\n", v - finalBase + invalidToken_errorCode);
+            else
+                printf("            code = %d; goto accept;\n", v - finalBase + invalidToken_errorCode);
+        }
+        printf("    }\n\n");
+    }
+
+    printf("accept:\n    acceptToken(lx, code, charRead, c, s);\n    finishToken(lx, buffer, eofFlag, s);\n    return;\n");
+    printf("reject:\n    rejectToken(lx, buffer, code, s);\n    finishToken(lx, buffer, eofFlag, s);\n    return;\n");
+    printf("tooLong:\n    rejectToken(lx, buffer, tooLong_errorCode, s);\n    finishToken(lx, buffer, eofFlag, s);\n    return;\n");
+    printf("finish:\n    finishToken(lx, buffer, eofFlag, s);\n}\n\n");
+    printf("#undef driverShift\n#undef driverRunShift\n\n#endif\n");
+}
+
+
+int main (int argc, char *argv[]) {
+    buildAutomaton();
+    compactColumns();
+    minimizeStates();
+    findKeywordHash();
+    if (argc > 1 && strcmp(argv[1], "direct") == 0) emitDirect();
+    else emitTables();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,351 @@
+/*
+ ============================================================================
+ Name        : genParser.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Build time generator of the LL(1) parse table (see llParser.c).
+                The CFG of the README is written here once, in LL(1) form:
+                 - the right recursive rules of <expr>, <M> and <T> are split
+                   into a head and a tail (<mExpr>, <mM>, <mT>), the same way
+                   <mvars> and <mStat> already are
+                 - the tree is built by actions (#name) placed in the rules:
+                   an action is run when the parser pops it, and builds the
+                   same nodes, in the same order, as the recursive descent
+                   parser (parser.c). An action right after a terminal works
+                   on the token that terminal matched.
+                FIRST and FOLLOW sets are computed, every table entry is
+                checked for a conflict, and the result is written to stdout
+                as a C header holding read-only tables (see parseTable.h).
+ Functions	 : int symbolOf (const char *name)
+                void readGrammar ()
+                void findFirst ()
+                void findFollow ()
+                void buildTable ()
+                void emitTables ()
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./token.h"
+
+//symbols : terminals are token kinds (0 .. eofKind) and classes of token kinds,
+//then come the non-terminals and the actions, so a symbol fits in one byte
+#define nKinds (eofKind + 1)            // one column per token kind
+#define classBase (nKinds)              // classes of token kinds (RO)
+#define nonterminalBase (64)
+#define actionBase (128)
+#define maxSymbols (256)
+#define maxProductions (64)
+#define maxLength (12)                  // symbols on the right side of a production
+
+//the CFG in LL(1) form, one non-terminal per line, alternatives split by |
+static const char *grammar[] = {
+    "<program> -> #program <vars> <block> #up",
+    "<block>   -> #block <body>",
+    "<body>    -> Begin <vars> <stats> End #up",
+    "<vars>    -> #vars Var Identifier #declare <mvars> #up | empty",
+    "<mvars>   -> : : Identifier #declareMore <mvars> | . | empty",
+    "<stats>   -> #stats <stat> <mStat> #up | empty",
+    "<mStat>   -> <stat> <mStat> | empty",
+    "<stat>    -> #stat <in> #up | #stat <out> #up | #stat <block> #up | #stat <if> #up | #stat <loop> #up | #stat <assign> #up",
+    "<in>      -> #in Scan : Identifier #read . #up",
+    "<out>     -> #out Print [ <expr> ] . #up",
+    "<if>      -> #if [ #cond <expr> RO #value <expr> ] Iff #up <body> #up",
+    "<loop>    -> #loop Loop #cond [ <expr> RO #value <expr> ] #up <body> #up",
+    "<assign>  -> #assign Identifier #target == #value <expr> . #up",
+    "<expr>    -> <M> <mExpr>",
+    "<mExpr>   -> #binary + <expr> #up | empty",
+    "<M>       -> <T> <mM>",
+    "<mM>      -> #binary - <M> #up | empty",
+    "<T>       -> <F> <mT>",
+    "<mT>      -> #binary * <T> #up | #binary / <T> #up | empty",
+    "<F>       -> #neg - <F> #up | <R>",
+    "<R>       -> [ <expr> ] | Identifier #use | Number #int",
+    NULL
+};
+
+//terminals of the CFG and their token kinds, RO stands for the relational operators
+static const struct { const char *name; int kind; } terminals[] = {
+    { "Begin", beginKeyword }, { "End", endKeyword }, { "Var", varKeyword }, { "Scan", scanKeyword },
+    { "Print", printKeyword }, { "Iff", iffKeyword }, { "Loop", loopKeyword },
+    { "Identifier", identifierKind }, { "Number", integerKind }, { "EOF", eofKind },
+    { ":", colonOperator }, { ".", dotDelimiter }, { "[", openBracketDelimiter }, { "]", closeBracketDelimiter },
+    { "+", plusOperator }, { "-", minusOperator }, { "*", timesOperator }, { "/", divideOperator },
+    { "==", assignOperator }, { "RO", classBase }, { NULL, 0 }
+};
+static const int relationalKinds[] = { equalOperator, lessOperator, greaterOperator,
+                                       notEqualOperator, greaterEqualOperator, lessEqualOperator, -1 };
+
+char *names[maxSymbols];                // symbol -> name
+int nNonterminals = 0, nActions = 0;
+int lhs[maxProductions];                // production -> non-terminal
+int rhs[maxProductions][maxLength];     // production -> symbols
+int rhsLength[maxProductions];
+int nProductions = 0;
+char nullable[maxSymbols];
+char first[maxSymbols][nKinds];         // FIRST of a symbol, over token kinds
+char follow[maxSymbols][nKinds];
+int table[nonterminalBase][nKinds];     // non-terminal x token kind -> production, -1 for an error
+
+
+//the token kinds a terminal matches
+int matches (int symbol, int kind) {
+    int i;
+    if (symbol != classBase) return symbol == kind;
+    for (i = 0; relationalKinds[i] >= 0; i++) if (relationalKinds[i] == kind) return 1;
+    return 0;
+}
+
+
+/*****************
+ * Function:
+ *      symbolOf
+ * Description:
+ *      Find the symbol of a name of the CFG, new non-terminals and actions
+ *      are numbered as they are met
+ * Input:
+ *      a terminal, a <non-terminal> or an #action
+ * Output:
+ *      its symbol
+ *****************/
+int symbolOf (const char *name) {
+    int i;
+    for (i = 0; terminals[i].name != NULL; i++) {
+        if (strcmp(name, terminals[i].name) == 0) {
+            if (names[terminals[i].kind] == NULL) names[terminals[i].kind] = strdup(name);
+            return terminals[i].kind;
+        }
+    }
+    if (name[0] != '<' && name[0] != '#') {
+        fprintf(stderr, "genParser: unknown terminal %s\n", name);
+        exit(EXIT_FAILURE);
+    }
+    for (i = nonterminalBase; i<maxSymbols; i++) if (names[i] != NULL && strcmp(names[i], name) == 0) return i;
+    if (name[0] == '<') i = nonterminalBase + nNonterminals++;
+    else i = actionBase + nActions++;
+    names[i] = strdup(name);
+    return i;
+}
+
+
+/*****************
+ * Function:
+ *      readGrammar
+ * Description:
+ *      Split the CFG into productions, one per alternative
+ * Input:
+ *      none
+ * Output:
+ *      the global productions filled in, the start symbol first
+ *****************/
+void readGrammar () {
+    int g;
+    char line[512], *word, *save;
+    for (g = 0; grammar[g] != NULL; g++) {
+        int left;
+        snprintf(line, sizeof(line), "%s", grammar[g]);
+        left = symbolOf(strtok_r(line, " ", &save));
+        strtok_r(NULL, " ", &save);                                // ->
+        lhs[nProductions] = left;
+        rhsLength[nProductions] = 0;
+        while ((word = strtok_r(NULL, " ", &save)) != NULL) {
+            if (strcmp(word, "|") == 0) {
+                lhs[++nProductions] = left;
+                rhsLength[nProductions] = 0;
+            } else if (strcmp(word, "empty") != 0) {
+                rhs[nProductions][rhsLength[nProductions]++] = symbolOf(word);
+            }
+        }
+        nProductions++;
+    }
+}
+
+
+/*****************
+ * Function:
+ *      findFirst
+ * Description:
+ *      Compute which symbols derive the empty string and the FIRST set of
+ *      every symbol, until nothing changes. Actions derive the empty string.
+ * Input:
+ *      none
+ * Output:
+ *      the global nullable and first sets
+ *****************/
+void findFirst () {
+    int s, k, p, i, changed = 1;
+    for (s = 0; s<nonterminalBase; s++) for (k = 0; k<nKinds; k++) first[s][k] = matches(s, k);
+    for (s = actionBase; s<maxSymbols; s++) nullable[s] = 1;
+    while (changed) {
+        changed = 0;
+        for (p = 0; p<nProductions; p++) {
+            int all = 1;
+            for (i = 0; i<rhsLength[p] && all; i++) {
+                for (k = 0; k<nKinds; k++) {
+                    if (first[rhs[p][i]][k] && !first[lhs[p]][k]) first[lhs[p]][k] = changed = 1;
+                }
+                all = nullable[rhs[p][i]];
+            }
+            if (all && !nullable[lhs[p]]) nullable[lhs[p]] = changed = 1;
+        }
+    }
+}
+
+
+/*****************
+ * Function:
+ *      findFollow
+ * Description:
+ *      Compute the FOLLOW set of every non-terminal, until nothing changes.
+ *      The start symbol is followed by EOF.
+ * Input:
+ *      none
+ * Output:
+ *      the global follow sets
+ *****************/
+void findFollow () {
+    int k, p, i, j, changed = 1;
+    follow[nonterminalBase][eofKind] = 1;
+    while (changed) {
+        changed = 0;
+        for (p = 0; p<nProductions; p++) {
+            for (i = 0; i<rhsLength[p]; i++) {
+                int s = rhs[p][i], all = 1;
+                if (s < nonterminalBase || s >= actionBase) continue;
+                for (j = i + 1; j<rhsLength[p] && all; j++) {
+                    for (k = 0; k<nKinds; k++) if (first[rhs[p][j]][k] && !follow[s][k]) follow[s][k] = changed = 1;
+                    all = nullable[rhs[p][j]];
+                }
+                if (all) {
+                    for (k = 0; k<nKinds; k++) if (follow[lhs[p]][k] && !follow[s][k]) follow[s][k] = changed = 1;
+                }
+            }
+        }
+    }
+}
+
+
+/*****************
+ * Function:
+ *      buildTable
+ * Description:
+ *      Fill the parse table: a production is picked on the FIRST set of its
+ *      right side, and on the FOLLOW set of its non-terminal when the right
+ *      side derives the empty string. Two productions on one entry is a
+ *      conflict, the CFG is then not LL(1) and nothing is generated.
+ * Input:
+ *      none
+ * Output:
+ *      the global table filled with productions
+ *****************/
+void buildTable () {
+    int n, k, p, i, conflicts = 0;
+    for (n = 0; n<nNonterminals; n++) for (k = 0; k<nKinds; k++) table[n][k] = -1;
+    for (p = 0; p<nProductions; p++) {
+        char pick[nKinds];
+        int all = 1;
+        memset(pick, 0, sizeof(pick));
+        for (i = 0; i<rhsLength[p] && all; i++) {
+            for (k = 0; k<nKinds; k++) if (first[rhs[p][i]][k]) pick[k] = 1;
+            all = nullable[rhs[p][i]];
+        }
+        if (all) for (k = 0; k<nKinds; k++) if (follow[lhs[p]][k]) pick[k] = 1;
+        for (k = 0; k<nKinds; k++) {
+            if (!pick[k]) continue;
+            n = lhs[p] - nonterminalBase;
+            if (table[n][k] >= 0 && table[n][k] != p) {
+                fprintf(stderr, "genParser: LL(1) conflict in %s on token kind %d\n", names[lhs[p]], k);
+                conflicts++;
+            }
+            table[n][k] = p;
+        }
+    }
+    if (conflicts > 0) exit(EXIT_FAILURE);
+}
+
+
+//an action name as a C name : #declareMore -> actionDeclareMore
+void printAction (int s) {
+    printf("action%c%s", names[s][1] - 'a' + 'A', names[s] + 2);
+}
+
+
+/*****************
+ * Function:
+ *      emitTables
+ * Description:
+ *      Write the parse table, the productions and the symbol names as a
+ *      C header
+ * Input:
+ *      none
+ * Output:
+ *      parseTable.h on stdout
+ *****************/
+void emitTables () {
+    int s, n, k, p, i, at = 0;
+    printf("/*\n * parseTable.h - generated by genParser at build time, do not edit.\n");
+    printf(" * %d non-terminals x %d token kinds, %d productions, %d actions\n */\n\n", nNonterminals, nKinds, nProductions, nActions);
+    printf("#ifndef _PARSETABLE_H_\n#define _PARSETABLE_H_\n\n");
+    printf("#define parseKinds (%d)                  // columns : token kinds\n", nKinds);
+    printf("#define parseClass (%d)                  // RO : a relational operator\n", classBase);
+    printf("#define parseNonterminal (%d)            // symbols >= parseNonterminal are non-terminals\n", nonterminalBase);
+    printf("#define parseAction (%d)                // symbols >= parseAction are actions\n", actionBase);
+    printf("#define parseStart (%d)                  // <program>\n\n", nonterminalBase);
+    for (s = actionBase; s<actionBase + nActions; s++) {
+        printf("#define ");
+        printAction(s);
+        printf(" (%d)\n", s);
+    }
+
+    printf("\n//token kind -> class of token kinds it belongs to (parseClass), 0 for none\n");
+    printf("static const unsigned char parseClassOf[parseKinds] = {");
+    for (k = 0; k<nKinds; k++) printf(" %d,", matches(classBase, k) ? classBase : 0);
+    printf(" };\n\n");
+
+    printf("//non-terminal x token kind -> production, -1 for a syntax error\n");
+    printf("static const signed char parseTable[%d][parseKinds] = {", nNonterminals);
+    for (n = 0; n<nNonterminals; n++) {
+        printf("\n    {");
+        for (k = 0; k<nKinds; k++) printf("%3d,", table[n][k]);
+        printf(" },");
+    }
+    printf("\n};\n\n");
+
+    printf("//production -> its right side, symbols parseRight[parseAt[p]] .. parseRight[parseAt[p + 1] - 1]\n");
+    printf("static const unsigned char parseRight[] = {");
+    for (p = 0; p<nProductions; p++) {
+        printf("\n    /* %2d %-9s */", p, names[lhs[p]]);
+        for (i = 0; i<rhsLength[p]; i++) printf(" %d,", rhs[p][i]);
+    }
+    printf("\n};\n");
+    printf("static const unsigned short parseAt[%d] = {", nProductions + 1);
+    for (p = 0; p<=nProductions; p++) {
+        if (p % 16 == 0) printf("\n    ");
+        printf("%d,", at);
+        if (p < nProductions) at += rhsLength[p];
+    }
+    printf("\n};\n\n");
+
+    printf("//terminal or non-terminal -> name, for the error messages\n");
+    printf("static const char *const parseNames[parseAction] = {");
+    for (s = 0; s<actionBase; s++) {
+        if (s % 8 == 0) printf("\n    ");
+        printf("\"%s\", ", names[s] == NULL ? "" : names[s]);
+    }
+    printf("\n};\n\n#endif\n");
+}
+
+
+int main (int argc, char *argv[]) {
+    readGrammar();
+    findFirst();
+    findFollow();
+    buildTable();
+    emitTables();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,239 @@
+/*
+ ============================================================================
+ Name        : llParser.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the LL(1) parser engine declared in llParser.h
+                The engine pops one symbol at a time from its stack:
+                 - a terminal is matched against the current token
+                 - a non-terminal is replaced by the right side of the
+                   production found in the parse table, for the current token
+                 - an action builds the tree (see genParser.c)
+                A token is only read when a symbol needs it, so the tokens
+                after the End of the program are never scanned, as with the
+                recursive descent parser.
+ Functions	 : int currentToken (myCompiler c)
+                void pushSymbol (struct Stacks *st, unsigned char symbol)
+                void pushNode (struct Stacks *st, Treeptr node)
+                int runAction (myCompiler c, struct Stacks *st, int action)
+                void llParser (myCompiler c)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./llParser.h"
+#include "./token.h"
+#include "./tokenStream.h"
+#include "./parseTable.h"
+
+//the token state is kept in the compilation context (see compiler.h), the
+//stacks belong to one call of llParser
+struct Stacks {
+    unsigned char *symbols;             // stack of symbols still to parse
+    long nSymbols, roomSymbols;
+    Treeptr *nodes;                     // stack of open nodes, the top one gets the new nodes
+    long nNodes, roomNodes;
+};
+
+
+/*****************
+ * Function:
+ *      currentToken
+ * Description:
+ *      This function is internal to the ADT.
+ *      Read the next token if the current one was matched
+ * Input:
+ *      a compilation context ADT
+ * Output:
+ *      1 if there is a token to parse, 0 on a scanner error
+ *****************/
+static int currentToken (myCompiler c) {
+    if (c->pending) {
+        c->t = streamToken(c->tokens, ++c->position);
+        c->kind = lexemeKind(c->t);
+        c->line = c->t->line;
+        c->pending = 0;
+        if (lexemeError(c->tokens, c->t) != 0 && c->kind != eofKind) {
+            diagnose(c, stderr, "[SYSTEM] Cannot get more information or EOF is reached\n");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+//push a symbol on the parser stack, making room when it is full
+static void pushSymbol (struct Stacks *st, unsigned char symbol) {
+    if (st->nSymbols == st->roomSymbols) {
+        st->roomSymbols *= 2;
+        st->symbols = realloc(st->symbols, st->roomSymbols);
+    }
+    st->symbols[st->nSymbols++] = symbol;
+}
+
+
+//push an open node, the nodes built from now on are added to it
+static void pushNode (struct Stacks *st, Treeptr node) {
+    if (st->nNodes == st->roomNodes) {
+        st->roomNodes *= 2;
+        st->nodes = realloc(st->nodes, st->roomNodes * sizeof(Treeptr));
+    }
+    st->nodes[st->nNodes++] = node;
+}
+
+
+/*****************
+ * Function:
+ *      runAction
+ * Description:
+ *      This function is internal to the ADT.
+ *      Build the nodes of an action, with the same names, values and
+ *      scopes as the recursive descent parser. The actions
+ *      placed after a terminal use the token it matched, the others open a
+ *      node on the next token.
+ * Input:
+ *      a compilation context ADT, the parser stacks and an action symbol
+ *      (see parseTable.h)
+ * Output:
+ *      1 if done, 0 on a scanner error
+ *****************/
+static int runAction (myCompiler c, struct Stacks *st, int action) {
+    Treeptr top = (st->nNodes > 0) ? st->nodes[st->nNodes - 1] : NULL, node;
+    switch (action) {
+        case actionUp:
+            st->nNodes--;
+            return 1;
+        case actionDeclare:
+        case actionDeclareMore:
+        case actionRead:
+        case actionTarget:
+        case actionUse:
+            buildIdTree(c, c->t->value, top);
+            return 1;
+        case actionInt:
+            buildTree(c, "<INT>", lexemeCopy(c->tokens, c->t, c->tokenText, sizeof(c->tokenText)), top);
+            return 1;
+        case actionValue:
+            lexemeCopy(c->tokens, c->t, top->value, sizeof(top->value));
+            return 1;
+        default:
+            break;
+    }
+
+    if (currentToken(c) == 0) return 0;
+    switch (action) {
+        case actionProgram:
+            pushNode(st, buildTree(c, "<program>", "", NULL));
+            break;
+        case actionVars:
+            pushNode(st, buildTree(c, "<vars>", "", top));
+            break;
+        case actionBlock:
+            node = buildTree(c, "<block>", "", top);
+            node->scope = top->scope + 1;
+            pushNode(st, node);
+            break;
+        case actionStats:
+            pushNode(st, buildTree(c, "<Stats>", "", top));
+            break;
+        case actionStat:
+            pushNode(st, buildTree(c, "<stat>", "", top));
+            break;
+        case actionIn:
+            pushNode(st, buildTree(c, "<In>", "", top));
+            break;
+        case actionOut:
+            pushNode(st, buildTree(c, "<Out>", "", top));
+            break;
+        case actionIf:
+            pushNode(st, buildTree(c, "<If>", "", top));
+            break;
+        case actionLoop:
+            pushNode(st, buildTree(c, "<Loop>", "", top));
+            break;
+        case actionCond:                                      // <RO> then <block> under <If> or <Loop>, <RO> is open first
+            node = buildTree(c, "<RO>", "", top);
+            pushNode(st, buildTree(c, "<block>", "", top));
+            st->nodes[st->nNodes - 1]->scope = top->scope + 1;
+            pushNode(st, node);
+            break;
+        case actionAssign:
+            pushNode(st, buildTree(c, "<assign>", "", top));
+            break;
+        case actionBinary:                                    // the left operand is the last node added to top
+            pushNode(st, adoptTree(c, "<expr>", lexemeCopy(c->tokens, c->t, c->tokenText, sizeof(c->tokenText)), top, treeChild(top, top->nChildren - 1)));
+            break;
+        case actionNeg:
+            pushNode(st, buildTree(c, "<neg>", lexemeCopy(c->tokens, c->t, c->tokenText, sizeof(c->tokenText)), top));
+            break;
+        default:
+            break;
+    }
+    return 1;
+}
+
+
+/*****************
+ * Function:
+ *      llParser
+ * Description:
+ *      Parse a program with the LL(1) parse table and build its tree
+ * Input:
+ *      a compilation context ADT
+ * Output:
+ *      the parsed tree in c->tree, errors on stderr; parsing stops at
+ *      the first syntax error
+ *****************/
+void llParser (myCompiler c) {
+    struct Stacks st;
+    int symbol, production, i, ok = 1;
+
+    c->tokens = openTokenStream(c->scanner);
+    if (c->tokens == NULL) return;
+    c->position = -1;
+    c->pending = 1;
+    st.roomSymbols = st.roomNodes = parseStackRoom;
+    st.symbols = malloc(st.roomSymbols);
+    st.nodes = malloc(st.roomNodes * sizeof(Treeptr));
+    st.nSymbols = st.nNodes = 0;
+    pushSymbol(&st, parseStart);
+
+    while (st.nSymbols > 0 && ok && c->errors < errorCap) {
+        symbol = st.symbols[--st.nSymbols];
+        if (symbol >= parseAction) {
+            ok = runAction(c, &st, symbol);
+        } else if (symbol >= parseNonterminal) {
+            if ((ok = currentToken(c)) == 0) break;
+            production = parseTable[symbol - parseNonterminal][c->kind];
+            if (production < 0) {
+                reportError(c, stderr, "[ERROR : line %d] Incorrect syntax. Unexpected token [%s] in %s. \n", c->t->line+1,
+                        lexemeCopy(c->tokens, c->t, c->tokenText, sizeof(c->tokenText)), parseNames[symbol]);
+                ok = 0;
+            } else {
+                for (i = parseAt[production + 1] - 1; i>=parseAt[production]; i--) pushSymbol(&st, parseRight[i]);
+            }
+        } else {
+            if ((ok = currentToken(c)) == 0) break;
+            if (symbol == c->kind || symbol == parseClassOf[c->kind]) {
+                c->pending = 1;
+            } else {
+                reportError(c, stderr, "[ERROR : line %d] Incorrect syntax. Missing '%s'. \n", c->t->line+1, parseNames[symbol]);
+                ok = 0;
+            }
+        }
+    }
+
+    depthTree(c);
+    if (!c->pending && c->kind == eofKind && c->errors < errorCap) {
+        diagnose(c, stderr, "[EOF] Parsing reached the end of file.\n");
+    }
+    free(st.symbols);
+    free(st.nodes);
+    clearTokenStream(c->tokens);
+    c->tokens = NULL;
+}
@@ -0,0 +1,44 @@
+/*
+ ============================================================================
+ Name        : llParser.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Table-driven LL(1) parser engine. The parse table is generated
+                from the CFG at build time (see genParser.c and parseTable.h),
+                and the parser keeps its own stacks of symbols and tree nodes
+                on the heap: the depth of the program is only limited by
+                memory, not by the call stack, and each step is one table
+                lookup. The tree is the same as with the recursive descent
+                parser (see parser.c), the scopes are checked afterwards.
+                On a syntax error, the error is reported and parsing stops;
+                the tree holds what was parsed so far.
+
+ ============================================================================
+ */
+
+#ifndef _LLPARSER_H_
+#define _LLPARSER_H_
+
+#include "./compiler.h"
+#include "./buildTree.h"
+
+//configuration : initial room in the parser stacks, doubled when full
+#define parseStackRoom (256)
+
+
+/*****************
+ * Function:
+ *      llParser
+ * Description:
+ *      Parse a program with the LL(1) parse table and build its tree,
+ *      a drop-in replacement for parser (see parser.h)
+ * Input:
+ *      a compilation context ADT
+ * Output:
+ *      the parsed tree in c->tree, errors on stderr
+ *****************/
+void llParser (myCompiler c);
+
+#endif
@@ -19,15 +19,27 @@
 #include "./scanner.h"
 #include "./token.h"
 #include "./parser.h"
+#include "./llParser.h"
+#include "./parallelParser.h"
 #include "./buildTree.h"
 #include "./traversals.h"
 #include "./scopeCheck.h"
+#include "./exprDag.h"
+#include "./storage.h"
+#include "./compiler.h"
 
+//configuration : threads used to scan and parse a named source (small sources use one)
+#define scanThreads (4)
+//configuration : parser engine, recursive descent, LL(1) table or recursive descent on threads,
+//or'ed with trustedSource to skip the scope checks, sharedExpressions to share expressions
+//and scopedStorage to overlay the variables of sibling blocks (see compiler.h)
+#define parserEngine (parallelDescent)
 
 int main(int argc, char *argv[])
 {
-    myScanner scanIt;                      // init scanner
-                                           //init tree
+    myScanner scanIt = NULL;               // init scanner
+    myCompiler c;                          // init compilation context (tree, scopes, ASM)
+    int status = EXIT_SUCCESS;             // EXIT_FAILURE once an output could not be written
     
 	char *prog = argv[0];                  // capture program name here
 	char treeFile[25], asmFile[25];
@@ -40,7 +52,7 @@ int main(int argc, char *argv[])
 	    {
 	        snprintf(treeFile, sizeof(treeFile), "%s.tree", argv[1]);
 	        snprintf(asmFile, sizeof(asmFile), "%s.asm", argv[1]);
-	        scanIt = scanByName(argv[1]);   // if file name specified, read from file
+	        scanIt = useThreads(scanByName(argv[1]), scanThreads);   // if file name specified, read from file
             
         }
 	  else
@@ -51,14 +63,28 @@ int main(int argc, char *argv[])
         }
 
 	    
-    parser(scanIt, theTree);
-    TravPreOrder(theTree, 0, treeFile);
-    generateASM(theTree, asmFile);
+    c = newCompiler(scanIt);
+    if (c == NULL) return EXIT_FAILURE;     // the scanner reported it
+    if ((parserEngine & engineMask) == tableParser) llParser(c);
+    else if ((parserEngine & engineMask) == parallelDescent) parallelParser(c);
+    else parser(c);
+    if (!(parserEngine & trustedSource)) scope_checkTree(c);
+    if (parserEngine & scopedStorage) layoutStorage(c);
+    if (parserEngine & sharedExpressions) shareTree(c);
+    if (TravPreOrder(c, c->tree, 0, treeFile) != 0) {
+        fprintf (stderr,"ERROR: Cannot write %s: %s \n", treeFile, strerror(errno));
+        status = EXIT_FAILURE;
+    }
+    if (generateASM(c, c->tree, asmFile) != 0) {
+        fprintf (stderr,"ERROR: Cannot write %s: %s \n", asmFile, strerror(errno));
+        status = EXIT_FAILURE;
+    }
+    clearCompiler (c);
     clearScanner (scanIt);
 
-    //scope_print();
+    //scope_print(c);
    
    
 
-	return EXIT_SUCCESS;
+	return status;
 }
@@ -0,0 +1,320 @@
+/*
+ ============================================================================
+ Name        : parallelParser.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the parallel parser engine declared in parallelParser.h
+ Functions	 : void matchBlocks (struct ParseJobs *js, myTokenStream ts, long count)
+                long queueBlock (myCompiler c, Treeptr blockNode)
+                void *parseJobs (void *arg)
+                int runJobs (myCompiler c, struct ParseJobs *js)
+                void relabelTree (myCompiler c, struct ParseJobs *js)
+                int parseBlocks (myCompiler c, long count)
+                void parallelParser (myCompiler c)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "./parallelParser.h"
+#include "./parser.h"
+#include "./tokenStream.h"
+
+//a block left to the threads
+struct ParseJob {
+    Treeptr node;                   // its <block> node, built by the main thread
+    long begin, end;                // positions of its Begin and of its End
+    int labelsBefore;               // nodes the main thread built before it
+    int labels;                     // nodes the thread built for it
+    int done;                       // 1 if it was parsed without error, up to its End
+};
+
+struct ParseJobs {
+    long *ends;                     // position of the End of the block of each Begin, -1 if none
+    struct ParseJob *list;          // blocks in source order
+    int count, room;
+    int next;                       // next block for a thread
+    pthread_mutex_t lock;           // guards next
+};
+
+//one thread, with a context of its own
+struct ParseWorker {
+    myCompiler c;
+    struct ParseJobs *js;
+    pthread_t thread;
+    int started;
+};
+
+
+/*****************
+ * Function:
+ *      matchBlocks
+ * Description:
+ *      This function is internal to the ADT.
+ *      Match every Begin of the tokens with its End, in one pass over the
+ *      tokens with a stack of the Begins still open
+ * Input:
+ *      the jobs, a token stream holding every token and their count
+ * Output:
+ *      js->ends
+ *****************/
+static void matchBlocks (struct ParseJobs *js, myTokenStream ts, long count) {
+    long *open = malloc(count * sizeof(long));
+    long i, n = 0;
+    int kind;
+    js->ends = malloc(count * sizeof(long));
+    for (i = 0; i<count; i++) {
+        js->ends[i] = -1;
+        kind = lexemeKind(streamToken(ts, i));
+        if (kind == beginKeyword) open[n++] = i;
+        else if (kind == endKeyword && n > 0) js->ends[open[--n]] = i;
+    }
+    free(open);
+}
+
+
+/*****************
+ * Function:
+ *      queueBlock
+ * Description:
+ *      Hand a block to the threads, when it is nested right in the main
+ *      block and its End was found
+ * Input:
+ *      a compilation context ADT with jobs, the <block> node
+ * Output:
+ *      the position of the End of the block, -1 if the parser has to parse
+ *      the block itself
+ *****************/
+long queueBlock (myCompiler c, Treeptr blockNode) {
+    struct ParseJobs *js = c->jobs;
+    struct ParseJob *job;
+    long begin = c->position - 1;               // the Begin, the parser already read the next token
+    if (blockNode->scope != jobScope || begin < 0 || js->ends[begin] < 0) return -1;
+    if (js->count == js->room) {
+        js->room = js->room * 2;
+        js->list = realloc(js->list, js->room * sizeof(struct ParseJob));
+    }
+    job = &js->list[js->count++];
+    job->node = blockNode;
+    job->begin = begin;
+    job->end = js->ends[begin];
+    job->labelsBefore = c->labels;
+    job->labels = 0;
+    job->done = 0;
+    return job->end;
+}
+
+
+/*****************
+ * Function:
+ *      parseJobs
+ * Description:
+ *      This function is internal to the ADT.
+ *      Thread body: parse blocks until none is left. A block is parsed as
+ *      the serial parser would from its Begin, the tokens after its End
+ *      read as EOF: a block parsed without error is the one of parser.c
+ * Input:
+ *      a worker
+ * Output:
+ *      the nodes of the blocks in the arena of the worker, the jobs done
+ *****************/
+static void *parseJobs (void *arg) {
+    struct ParseWorker *wk = arg;
+    struct ParseJobs *js = wk->js;
+    myCompiler w = wk->c;
+    struct ParseJob *job;
+    int k;
+    for (;;) {
+        pthread_mutex_lock(&js->lock);
+        k = js->next++;
+        pthread_mutex_unlock(&js->lock);
+        if (k >= js->count) break;
+        job = &js->list[k];
+        w->labels = 0;
+        w->errors = 0;
+        w->panic = 0;
+        w->position = job->begin;
+        w->t = streamToken(w->tokens, job->begin);
+        w->kind = beginKeyword;
+        w->line = w->t->line;
+        w->lastPosition = job->end + 1;
+        parseBlock(w, job->node);
+        job->labels = w->labels;
+        job->done = (w->errors == 0 && w->position == job->end + 1);
+    }
+    return NULL;
+}
+
+
+/*****************
+ * Function:
+ *      runJobs
+ * Description:
+ *      This function is internal to the ADT.
+ *      Parse the blocks on a pool of threads, the calling one included,
+ *      then give the nodes of the threads to the context
+ * Input:
+ *      a compilation context ADT and its jobs
+ * Output:
+ *      1 if every block was parsed without error, 0 otherwise
+ *****************/
+static int runJobs (myCompiler c, struct ParseJobs *js) {
+    struct ParseWorker workers[maxThreads];
+    int n = c->scanner->threads, k, done = 1;
+
+    if (n > js->count) n = js->count;
+    pthread_mutex_init(&js->lock, NULL);
+    js->next = 0;
+    for (k = 0; k<n; k++) {
+        workers[k].c = newCompiler(c->scanner);
+        workers[k].c->tokens = c->tokens;
+        workers[k].c->diagnostics = newTextBuffer();    // a block with an error is parsed again, its messages are dropped
+        workers[k].js = js;
+        workers[k].started = (k > 0 && pthread_create(&workers[k].thread, NULL, parseJobs, &workers[k]) == 0);
+    }
+    parseJobs(&workers[0]);
+    for (k = 0; k<n; k++) {
+        if (workers[k].started) pthread_join(workers[k].thread, NULL);
+        else if (k > 0) parseJobs(&workers[k]);             // no thread, the blocks left are parsed here
+        if (workers[k].c->staleDepths) c->staleDepths = 1;
+        mergeArena(c->arena, workers[k].c->arena);
+        workers[k].c->arena = NULL;
+        clearTextBuffer(workers[k].c->diagnostics);
+        clearCompiler(workers[k].c);
+    }
+    pthread_mutex_destroy(&js->lock);
+
+    for (k = 0; k<js->count; k++) done = done && js->list[k].done;
+    return done;
+}
+
+
+/*****************
+ * Function:
+ *      relabelTree
+ * Description:
+ *      This function is internal to the ADT.
+ *      Label the nodes in the order the serial parser builds them: the
+ *      nodes of a block come right after the nodes the main thread built
+ *      before it, and every later node moves up by the nodes of the blocks
+ *      before it. The nodes still to visit are kept on a stack.
+ * Input:
+ *      a compilation context ADT and its jobs, all done
+ * Output:
+ *      the labels of the tree, c->labels counts every node
+ *****************/
+static void relabelTree (myCompiler c, struct ParseJobs *js) {
+    struct { Treeptr node; int job; } *stack;
+    long n = 0, room = 256;
+    int *shift = calloc(c->labels + 2, sizeof(int));    // shift[l] : nodes of the blocks before the main node l
+    int *offset = malloc(js->count * sizeof(int));      // offset[k] : label of the node before the nodes of block k
+    int k, i, next = 0, job, total = 0;
+    Treeptr node;
+
+    for (k = 0; k<js->count; k++) {
+        offset[k] = js->list[k].labelsBefore + total;
+        shift[js->list[k].labelsBefore + 1] += js->list[k].labels;
+        total += js->list[k].labels;
+    }
+    for (i = 1; i<=c->labels; i++) shift[i] += shift[i - 1];
+
+    stack = malloc(room * sizeof(*stack));
+    stack[n].node = c->tree;
+    stack[n++].job = -1;
+    while (n > 0) {
+        node = stack[--n].node;
+        job = stack[n].job;
+        if (job < 0) {
+            node->label += shift[node->label];
+            if (next < js->count && js->list[next].node == node) job = next++;     // preorder meets the blocks in source order
+        } else node->label += offset[job];
+        if (n + node->nChildren > room) {
+            while (n + node->nChildren > room) room *= 2;
+            stack = realloc(stack, room * sizeof(*stack));
+        }
+        for (i = node->nChildren - 1; i>=0; i--) {
+            stack[n].node = node->children[i];
+            stack[n++].job = job;
+        }
+    }
+    c->labels += total;
+    free(stack);
+    free(offset);
+    free(shift);
+}
+
+
+/*****************
+ * Function:
+ *      parseBlocks
+ * Description:
+ *      This function is internal to the ADT.
+ *      Parse the program with the threads, quietly. The tree is kept only
+ *      if it is the one of the serial parser
+ * Input:
+ *      a compilation context ADT whose tokens are all scanned, their count
+ * Output:
+ *      1 if the tree is built, 0 if the program has to be parsed serially
+ *      (the context is then as before)
+ *****************/
+static int parseBlocks (myCompiler c, long count) {
+    struct ParseJobs js;
+    myTextBuffer diagnostics = c->diagnostics;
+    int ok;
+
+    matchBlocks(&js, c->tokens, count);
+    js.count = 0;
+    js.room = 64;
+    js.list = malloc(js.room * sizeof(struct ParseJob));
+    c->diagnostics = newTextBuffer();                   // messages of a program with errors, dropped
+    c->jobs = &js;
+    parseTokens(c);
+    c->jobs = NULL;
+    ok = (c->errors == 0 && c->tree != NULL);
+    if (ok && js.count > 0) ok = runJobs(c, &js);
+    clearTextBuffer(c->diagnostics);
+    c->diagnostics = diagnostics;
+
+    if (ok) {
+        relabelTree(c, &js);
+        depthTree(c);
+    } else {
+        clearTree(c);
+        c->errors = 0;
+        c->panic = 0;
+    }
+    free(js.ends);
+    free(js.list);
+    return ok;
+}
+
+
+/*****************
+ * Function:
+ *      parallelParser
+ * Description:
+ *      Parse a program with as many threads as its scanner allows, or
+ *      serially for a stream, a small program or a program with errors
+ * Input:
+ *      a compilation context ADT
+ * Output:
+ *      the parsed tree in c->tree, errors on stderr and stdout
+ *****************/
+void parallelParser (myCompiler c) {
+    long count;
+    if (c->scanner == NULL || c->scanner->threads < 2 || c->scanner->fd >= 0) {
+        parser(c);
+        return;
+    }
+    c->tokens = openTokenStream(c->scanner);
+    if (c->tokens == NULL) return;
+    count = streamAll(c->tokens);
+    if (count < parseMin || parseBlocks(c, count) == 0) parseTokens(c);
+    clearTokenStream(c->tokens);
+    c->tokens = NULL;
+}
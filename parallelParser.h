@@ -0,0 +1,68 @@
+/*
+ ============================================================================
+ Name        : parallelParser.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Parallel engine of the recursive descent parser. The tokens
+                are all scanned first (see streamAll), and one linear pass
+                matches every Begin with its End. The main thread parses the
+                program, but leaves each block nested right in the main block
+                (scope 2) to a pool of threads: it only jumps past its End.
+                Each thread parses its blocks with a context of its own over
+                the same tokens, the nodes go under the <block> node the main
+                thread built, and the arenas are merged afterwards.
+                The tree is then made the one the serial parser builds: the
+                nodes are labeled again in source order. The scopes are
+                checked afterwards, as for every engine (see scopeCheck.h).
+                Whenever the program has an error the serial parser would
+                stop on or recover from (scanner or syntax error), it is
+                parsed again serially, so the tree, the ASM and the messages
+                are always those of parser.c.
+                Sources read from a stream are parsed serially.
+
+ ============================================================================
+ */
+
+#ifndef _PARALLELPARSER_H_
+#define _PARALLELPARSER_H_
+
+#include "./compiler.h"
+#include "./buildTree.h"
+
+//configuration : scope of the blocks parsed by the threads, the ones nested in the main block
+#define jobScope (2)
+//configuration : smallest program worth the threads, in tokens
+#define parseMin (16384)
+
+
+/*****************
+ * Function:
+ *      parallelParser
+ * Description:
+ *      Parse a program with as many threads as its scanner allows (see
+ *      useThreads), and build the same tree as parser would
+ * Input:
+ *      a compilation context ADT
+ * Output:
+ *      the parsed tree in c->tree, errors on stderr and stdout
+ *****************/
+void parallelParser (myCompiler c);
+
+
+/*****************
+ * Function:
+ *      queueBlock
+ * Description:
+ *      Hand a block to the threads, called by the parser when it matched
+ *      the Begin of a block (the token before the current one)
+ * Input:
+ *      a compilation context ADT with jobs, the <block> node
+ * Output:
+ *      the position of the End of the block, -1 if the parser has to parse
+ *      the block itself
+ *****************/
+long queueBlock (myCompiler c, Treeptr blockNode);
+
+#endif
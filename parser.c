@@ -21,12 +21,15 @@
 #include <string.h>
 #include <dirent.h>
 #include <errno.h>
+#include <stdarg.h>
 
 #include "./scanner.h"
 #include "./token.h"
+#include "./tokenStream.h"
 #include "./parser.h"
 #include "./buildTree.h"
 #include "./traversals.h"
+#include "./parallelParser.h"
 
 //************************
 //THE CFG USED
@@ -51,8 +54,21 @@
 //<RO>       ->      >=> | <=< | = |  > | <  |  =!=           // each is one token here
 
 //************************
-// GLOBAL VARIABLES
-myToken t;      // note that t has {int tokenType, char tokenVal[bufLen] , int  tokenLine }
+// STATE
+// the parser keeps its state in the compilation context (see compiler.h):
+// c->tokens, c->position, the current token c->t and its kind c->kind,
+// the errors found so far c->errors and the panic flag c->panic
+// parallelParser runs it on several contexts sharing c->tokens: a context may be
+// told to stop at c->lastPosition, and to skip the blocks it hands to threads (c->jobs)
+// the parser only builds the tree, the scopes are checked afterwards (see scope_checkTree)
+
+//************************
+// ERROR RECOVERY (panic mode)
+// a syntax error is reported, then the parser panics: it goes on with the rule at
+// hand but reports no other syntax error (a cascade of the first one) until it is
+// back in step, at the start of a statement (see synchronize) or of a block.
+// Tokens the scanner rejected are counted and skipped. After errorCap errors the
+// parser sees the end of the source (see nextToken)
 
 
 //FUNCTION CODE
@@ -68,129 +84,201 @@ myToken t;      // note that t has {int tokenType, char tokenVal[bufLen] , int
 #define assign_parse_code   209
 #define get_next_token      299
 
+//BINDING POWERS of the binary operators of <expr>, see expr_power
+#define plusPower           1
+#define minusPower          2
+#define timesPower          3
+
 //FUNCTION PROTOTYPES
-void parser ( myScanner scanIt, Treeptr aTree );
-int program_parse (myScanner scanIt, Treeptr aTree );
-int block_parse (myScanner scanIt, Treeptr parentNode );
-int vars_parse (myScanner scanIt,  Treeptr parentNode );
-int stats_parse (myScanner scanIt,  Treeptr parentNode );
-int mvars_parse (myScanner scanIt,  Treeptr parentNode );
-int scan_parse (myScanner scanIt,  Treeptr parentNode );
-int print_parse (myScanner scanIt,  Treeptr parentNode );
-int iff_parse (myScanner scanIt,  Treeptr parentNode );
-int loop_parse (myScanner scanIt,  Treeptr parentNode );
-int assign_parse (myScanner scanIt,  Treeptr parentNode );
-int stat_parse (myScanner scanIt,  Treeptr parentNode );
-int mStat_parse (myScanner scanIt,  Treeptr parentNode );
-int exprs_parse(myScanner scanIt,  Treeptr parentNode );
-int expr_parse(myScanner scanIt,  Treeptr parentNode );
-int M_parse(myScanner scanIt,  Treeptr parentNode );
-int T_parse(myScanner scanIt,  Treeptr parentNode );
-int F_parse(myScanner scanIt,  Treeptr parentNode );
-int R_parse(myScanner scanIt,  Treeptr parentNode );
-
-int string2int (char aString[25]){
-    int temp = 0;
-    int ctr = 0;
-    for (ctr=0; ctr<strlen(aString); ctr++) {temp = temp + (int) aString[ctr];}
-    return temp;
+void parser ( myCompiler c );
+int program_parse (myCompiler c, Treeptr aTree );
+int block_parse (myCompiler c, Treeptr parentNode );
+int vars_parse (myCompiler c,  Treeptr parentNode );
+int stats_parse (myCompiler c,  Treeptr parentNode );
+int mvars_parse (myCompiler c,  Treeptr parentNode );
+int scan_parse (myCompiler c,  Treeptr parentNode );
+int print_parse (myCompiler c,  Treeptr parentNode );
+int iff_parse (myCompiler c,  Treeptr parentNode );
+int loop_parse (myCompiler c,  Treeptr parentNode );
+int assign_parse (myCompiler c,  Treeptr parentNode );
+int stat_parse (myCompiler c,  Treeptr parentNode );
+int mStat_parse (myCompiler c,  Treeptr parentNode );
+int exprs_parse(myCompiler c,  Treeptr parentNode );
+int expr_parse(myCompiler c,  Treeptr parentNode );
+int expr_power (int tokenKind);
+Treeptr expr_climb(myCompiler c,  Treeptr parentNode, int power, int *flag );
+Treeptr F_parse(myCompiler c,  Treeptr parentNode, int *flag );
+Treeptr R_parse(myCompiler c,  Treeptr parentNode, int *flag );
+
+//FIRST(<expr>) : - [ Identifier Number
+int expr_first (int tokenKind) {
+    switch (tokenKind) {
+        case minusOperator:
+        case openBracketDelimiter:
+        case identifierKind:
+        case integerKind:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+//read the next token, the tokens rejected by the scanner (which reported them) are
+//counted and skipped; after errorCap errors or past c->lastPosition, the current token
+//reads as the end of the source
+static void nextToken (myCompiler c) {
+    c->previousKind = c->kind;
+    while (c->errors < errorCap && (c->lastPosition < 0 || c->position < c->lastPosition)) {
+        c->t = streamToken(c->tokens, ++c->position);
+        c->kind = lexemeKind(c->t);
+        c->line = c->t->line;
+        if (lexemeError (c->tokens, c->t) == 0 || c->kind==eofKind) return;
+        reportError(c, stderr, NULL);
+    }
+    c->kind = eofKind;
+}
+
+//report a syntax error, unless the parser is in panic since an earlier one
+static void syntaxError (myCompiler c, const char *format, ...) {
+    va_list args;
+    if (c->panic == 0) {
+        va_start(args, format);
+        reportErrorList(c, stderr, format, args);
+        va_end(args);
+    }
+    c->panic = 1;
+}
+
+//1 if a statement may start at the current token: Scan, Print, Loop, Begin, the End
+//of the block, the end of the source, or an identifier or '[' right after a '.' or an End
+static int atStatement (myCompiler c) {
+    switch (c->kind) {
+        case scanKeyword:
+        case printKeyword:
+        case loopKeyword:
+        case beginKeyword:
+        case endKeyword:
+        case eofKind:
+            return 1;
+        case identifierKind:
+        case openBracketDelimiter:
+            return c->previousKind==dotDelimiter || c->previousKind==endKeyword;
+        default:
+            return 0;
+    }
+}
+
+//panic mode : skip the tokens up to the start of a statement, then report errors again;
+//at the end of the source the parser stays in panic, the blocks still open all miss their End
+static void synchronize (myCompiler c) {
+    while (!atStatement(c)) nextToken(c);
+    if (c->kind != eofKind) c->panic = 0;
 }
 
 // AUX function
-int launch (int code, myScanner scanIt, Treeptr parentNode ) {
+int launch (int code, myCompiler c, Treeptr parentNode ) {
     int temp = 0;
     //consume the matched token that calls the corresponding function
     //get the next token
-    clearToken(t);
-    if (t != NULL) {
-        memset(t->tokenVal,0,sizeof(t->tokenVal));           //preventing mem issues
-    }
+    nextToken(c);
 
-    if (hasTokenError (t = getToken(scanIt)) == 0 || strstr(t->tokenVal,"EOF")!=NULL) { // if there is no error
-        //call the function, feel free to enable, disable or inject troubleshooting routines to these switches
+    //call the function, feel free to enable, disable or inject troubleshooting routines to these switches
        switch (code) {
             case 200:
-                temp = program_parse (scanIt, parentNode);
+                temp = program_parse (c, parentNode);
                 break;
             case 201:
-                //printf("-block- %s\n", t->tokenVal);
-                temp = block_parse (scanIt, parentNode);
+                //printf("-block- %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
+                temp = block_parse (c, parentNode);
                 break;
             case 202:
-                temp = vars_parse (scanIt, parentNode);
+                temp = vars_parse (c, parentNode);
                 break;
             case 203:
-                //printf("-statS- %s\n", t->tokenVal);
-                temp = stats_parse (scanIt, parentNode);
+                //printf("-statS- %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
+                temp = stats_parse (c, parentNode);
                 break;
             case 204:
-                temp = mvars_parse (scanIt, parentNode);
+                temp = mvars_parse (c, parentNode);
                 break;
             case 205:
-                //printf("-scan- %s\n", t->tokenVal);
-                temp = scan_parse (scanIt, parentNode);
+                //printf("-scan- %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
+                temp = scan_parse (c, parentNode);
                 break;
             case 206: 
-                //printf("-print- %s\n", t->tokenVal);
-                temp = print_parse (scanIt, parentNode);
+                //printf("-print- %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
+                temp = print_parse (c, parentNode);
                 break;
             case 207:
-                //printf("-iff- %s\n", t->tokenVal);
-                temp = iff_parse (scanIt, parentNode);
+                //printf("-iff- %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
+                temp = iff_parse (c, parentNode);
                 break;
             case 208:
-                //printf("-loop- %s\n", t->tokenVal);
-                temp = loop_parse (scanIt, parentNode);
+                //printf("-loop- %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
+                temp = loop_parse (c, parentNode);
                 break;
             case 209:
-                //printf("-assign- %s\n", t->tokenVal);
-                temp = assign_parse (scanIt, parentNode);
+                //printf("-assign- %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
+                temp = assign_parse (c, parentNode);
                 break;
             default :
                 break;
        }
-    } else {
-    // display an error if there are issues with getting the token
-        fprintf(stderr, "[SYSTEM] Cannot get more information or EOF is reached\n");
-    }
     
     return temp;
 }
 //************************
 // FUNCTION IMPLEMENTATIONS
 
-void parser ( myScanner scanIt, Treeptr aTree ) {
+void parser ( myCompiler c ) {
     
-    launch (program_parse_code, scanIt, aTree);
-
-    if (t->tokenType == eofCode) {
-        fprintf(stderr, "[EOF] Parsing reached the end of file.\n");
-    }    
+    c->tokens = openTokenStream(c->scanner);
+    if (c->tokens == NULL) return;
+    parseTokens(c);
     
-    clearToken (t);
+    clearTokenStream (c->tokens);
+    c->tokens = NULL;
     return;
 }
 
+//parse the program from the first token of c->tokens
+void parseTokens ( myCompiler c ) {
+    c->position = -1;
+    c->kind = noKeyword;
+    launch (program_parse_code, c, NULL);      // the program is the root of c->tree
+    depthTree(c);
+
+    if (c->kind == eofKind && c->errors < errorCap) {
+        diagnose(c, stderr, "[EOF] Parsing reached the end of file.\n");
+    }    
+}
+
+//parse a block whose Begin is the current token, into its <block> node
+int parseBlock ( myCompiler c, Treeptr blockNode ) {
+    return launch (block_parse_code, c, blockNode);
+}
+
 //<program>  ->     <vars> <block>
 //Return 0 if no <vars> or <block> found
-int program_parse (myScanner scanIt, Treeptr aTree ) {
+int program_parse (myCompiler c, Treeptr aTree ) {
     //fprintf(stderr, "parsing ...\n");
-    aTree= buildTree("<program>","", aTree);
+    aTree= buildTree(c, "<program>","", aTree);
     Treeptr varNode, blockNode;
     
     int flag = 1;
-    if (strstr(t->tokenVal,"Var")!=NULL) {                              // if 'Var' is found
-        varNode = buildTree( "<vars>", "", aTree);
-        if (launch (vars_parse_code, scanIt, varNode)==0) flag--;       //call vars_parse
+    if (c->kind==varKeyword) {                              // if 'Var' is found
+        varNode = buildTree(c, "<vars>", "", aTree);
+        if (launch (vars_parse_code, c, varNode)==0) flag--;       //call vars_parse
     } 
-    if (strstr(t->tokenVal,"Begin")!=NULL) {                            // if 'Begin' is found (no <vars> section)
-        blockNode = buildTree("<block>", "", aTree);
-        blockNode->scope = aTree->scope + 1;
-        if (launch (block_parse_code, scanIt, blockNode)==0) flag--;
-    } else
-    {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing main program. \n", t->tokenLine);
+    if (c->kind!=beginKeyword) {
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing main program. \n", c->t->line+1);
         flag--;
+        while (c->kind!=beginKeyword && c->kind!=eofKind) nextToken(c);     // panic mode : the main program may still come
+    }
+    if (c->kind==beginKeyword) {                            // if 'Begin' is found (no <vars> section)
+        blockNode = buildTree(c, "<block>", "", aTree);
+        blockNode->scope = aTree->scope + 1;
+        if (launch (block_parse_code, c, blockNode)==0) flag--;
     }
     if (flag <=0) return 0;
     else 
@@ -200,57 +288,56 @@ int program_parse (myScanner scanIt, Treeptr aTree ) {
 
 //<block>    ->      Begin <vars> <stats> End
 //return 1 if success, <=0 if there's an error
-int block_parse (myScanner scanIt, Treeptr parentNode ) {
+int block_parse (myCompiler c, Treeptr parentNode ) {
     Treeptr varsNode,statsNode;
     int flag = 1;
+    long end;
+    c->panic = 0;                                           // Begin was matched, the parser is in step again
+    if (c->jobs != NULL && (end = queueBlock(c, parentNode)) >= 0) {
+        c->position = end;                                  // a thread parses the block, go on after its End
+        c->kind = endKeyword;
+        nextToken(c);
+        return flag;
+    }
     //launch <vars> section
-    if (strstr(t->tokenVal,"Var")!=NULL) {
-        varsNode = buildTree("<vars>", "", parentNode);
-        if ( launch(vars_parse_code, scanIt, varsNode)==0 ) flag--;
+    if (c->kind==varKeyword) {
+        varsNode = buildTree(c, "<vars>", "", parentNode);
+        if ( launch(vars_parse_code, c, varsNode)==0 ) flag--;
+        if (c->panic) synchronize(c);
     }
     // if vars is all empty, then we check for <stats>
     //<stats>    ->      <stat>  <mStat>
     // since <stat> is mandatory, in this step, we check members of <stat> 
     //and call function accordingly, note that we check qualifying condition for a function
     //before we call the function
-    if (strstr(t->tokenVal,"End")==NULL) {
-        statsNode = buildTree("<Stats>", "", parentNode);
-        if (stats_parse (scanIt, statsNode)<=0) flag--;                            //check for <stats>
+    if (c->kind!=endKeyword) {
+        statsNode = buildTree(c, "<Stats>", "", parentNode);
+        if (stats_parse (c, statsNode)<=0) flag--;                            //check for <stats>
     }
 
     
-    if (strstr(t->tokenVal,"End")!=NULL || strstr(t->tokenVal,"EOF")!=NULL)
+    if (c->kind==endKeyword)
     {
         if (parentNode->scope>1) {
-            if(launch (get_next_token, scanIt, parentNode)==0) flag--;
-            //printf(" block %s\n", t->tokenVal);
+            if(launch (get_next_token, c, parentNode)==0) flag--;
+            //printf(" block %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
         }
     } else {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Program has to be ended with an 'End' <block> \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Program has to be ended with an 'End' <block> \n", c->t->line+1);
         flag --;
     }
     return flag;
 }
 
 //<vars>     ->      empty | Var Identifier <mvars> 
-int vars_parse (myScanner scanIt, Treeptr parentNode ) {
-    Treeptr idNode;
+int vars_parse (myCompiler c, Treeptr parentNode ) {
     int flag = 1;
-    if (t->tokenType == idCode) {
-        idNode = buildTree( "<ID>", t->tokenVal, parentNode);
-        
-        //convert text variable to string 
-        char tempString[25];
-        strcpy(tempString,idNode->value );
-        //store it to scope arrays
-        if (scope_findDup (idNode->scope,string2int(tempString)) >0) {
-            fprintf(stderr, "[ERROR - line %d] : There is a scope conflict. Value: %s\n", t->tokenLine+2, idNode->value);
-        }else
-            scope_add(idNode->scope, string2int(tempString));
-        launch(mvars_parse_code, scanIt, parentNode);            // check for <mvars>
+    if (c->kind==identifierKind) {
+        buildIdTree(c, c->t->value, parentNode);
+        launch(mvars_parse_code, c, parentNode);            // check for <mvars>
     } else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing the body of variable declairation. \n", t->tokenLine);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing the body of variable declairation. \n", c->t->line+1);
         flag--;
     }
     if (flag <= 0) return 0;
@@ -260,52 +347,30 @@ int vars_parse (myScanner scanIt, Treeptr parentNode ) {
 
 
 //<mvars>    ->     empty | : : Identifier <mvars>
-int mvars_parse (myScanner scanIt, Treeptr parentNode ) {
-    Treeptr mvarsNode, idNode;
+//each : : Identifier adds its identifier to the <vars> node, next to the first one
+int mvars_parse (myCompiler c, Treeptr parentNode ) {
     int flag = 1;
-    if (t->tokenType==otherCode && t->tokenVal[0]==':') {     //reconizing :
-        if (launch (get_next_token, scanIt, parentNode)==0) flag--; //need to check the passing of tempNode here
-        if (t->tokenType==otherCode && t->tokenVal[0]==':') {       //recognizing : : , note there is a space in between
-            if (launch (get_next_token, scanIt, parentNode)==0) flag--;
-            if (t->tokenType == idCode) {                                   //if an identifier is found
-                mvarsNode = buildTree( "<mvars>", "", parentNode);
-                idNode = buildTree( "<ID>", t->tokenVal, mvarsNode);
-                
-                //convert text variable to string 
-                char tempString[25];
-                strcpy(tempString,idNode->value );
-                //store it to scope arrays
-                if (scope_findDup (idNode->scope,string2int(tempString)) >0) {
-                   fprintf(stderr, "[ERROR - line %d] : There is a scope conflict. Value: %s - Scope: %d\n", t->tokenLine+2, idNode->value, idNode->scope);
-                }else
-                    scope_add(idNode->scope, string2int(tempString));
-                
-                if(launch (get_next_token, scanIt, parentNode)==0) flag--;
-                if (strstr(t->tokenVal,".")!=NULL || strstr(t->tokenVal,":")!=NULL)
-                {
-                    mvars_parse (scanIt, mvarsNode);
-                }
-                //launch(mvars_parse_code, scanIt, mvarsNode);                // recognizing : : Identifier   
-            }
-            else {
-                fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing identifier. \n", t->tokenLine);
-            }
-
-            mvars_parse (scanIt, parentNode);
-        }  else
-        {
+    while (c->kind==colonOperator) {     //reconizing :
+        if (launch (get_next_token, c, parentNode)==0) flag--;
+        if (c->kind!=colonOperator) {       //recognizing : : , note there is a space in between
             flag--;
-            fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing another ':' \n", t->tokenLine);
+            syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing another ':' \n", c->t->line+1);
+            break;
+        }
+        if (launch (get_next_token, c, parentNode)==0) flag--;
+        if (c->kind==identifierKind) {                                   //if an identifier is found
+            buildIdTree(c, c->t->value, parentNode);
+            if(launch (get_next_token, c, parentNode)==0) flag--;
+        }
+        else {
+            syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing identifier. \n", c->t->line+1);
+            break;
         }
     }
     
     
-    if (strstr(t->tokenVal,".")!=NULL) {
-        if(launch (get_next_token, scanIt, parentNode)==0) flag--;
-    }
-                                                              //if not there
-    if (flag<1)
-        {if (t->tokenType!=keywordCode) fprintf(stderr, "[ERROR : line %d] Incorrect syntax of variable declaration. \n", t->tokenLine);
+    if (c->kind==dotDelimiter) {
+        if(launch (get_next_token, c, parentNode)==0) flag--;
     }
 
     return flag;
@@ -313,147 +378,120 @@ int mvars_parse (myScanner scanIt, Treeptr parentNode ) {
 
 //<stats>    ->      <stat>  <mStat>
 //note that launch function is not used in these function calls
-int stats_parse (myScanner scanIt, Treeptr parentNode ) {
+//every <stat> is added to the <Stats> node, side by side
+int stats_parse (myCompiler c, Treeptr parentNode ) {
     int flag = 1;
-    Treeptr statNode, mstatNode;
-    if (strstr(t->tokenVal,"End")==NULL) {
-        statNode = buildTree("<stat>", "", parentNode);
-        if (stat_parse (scanIt, statNode)<=0) flag--;                                             // check for <stat>
-        if (strstr(t->tokenVal,"End")==NULL) {
-            mstatNode = buildTree("<mStat>", "", parentNode);
-            mStat_parse (scanIt, mstatNode);                                       // check for <mStat>
-        }
-
-        //}    
+    Treeptr statNode;
+    if (c->kind!=endKeyword) {
+        statNode = buildTree(c, "<stat>", "", parentNode);
+        if (stat_parse (c, statNode)<=0) flag--;                                             // check for <stat>
+        if (c->panic) synchronize(c);                                                       // panic mode : on to the next <stat>
+        if (c->kind!=endKeyword) mStat_parse (c, parentNode);                                   // check for <mStat>
     }
     //no current token got consumed yet
     return flag;
 }
 
 //<mStat>    ->      empty | <stat>  <mStat>
-int mStat_parse (myScanner scanIt, Treeptr parentNode ) {
+//one round of the loop per <stat>, the parent is the <Stats> node
+int mStat_parse (myCompiler c, Treeptr parentNode ) {
     int flag = 1;
-    Treeptr statNode, mstatNode;
-    if (strstr(t->tokenVal,"End")==NULL && strstr(t->tokenVal,"EOF")==NULL) {
-        statNode = buildTree("<stat>","", parentNode);
-        if (stat_parse(scanIt, statNode)<=0) flag--;
-        if (strstr(t->tokenVal,"End")==NULL) {
-            mstatNode = buildTree("<mStat>", "", parentNode);
-            mStat_parse (scanIt, mstatNode);                                       // check for <mStat>
-        }
+    Treeptr statNode;
+    while (c->kind!=endKeyword && c->kind!=eofKind) {
+        statNode = buildTree(c, "<stat>","", parentNode);
+        if (stat_parse(c, statNode)<=0) flag--;
+        if (c->panic) synchronize(c);
     }
 
     return flag;
 }
 
 //<stat>     ->      <in> | <out> | <block> | <if> | <loop> | <assign>
-int stat_parse (myScanner scanIt, Treeptr parentNode ) {
-    Treeptr tempNode;
+int stat_parse (myCompiler c, Treeptr parentNode ) {
+    Treeptr tempNode = NULL;
     int flag = 0;
-    //printf("stat %s\n", t->tokenVal);
-    if (strstr(t->tokenVal,"Scan")!=NULL) {
-        flag++;
-        tempNode = buildTree( "<In>","", parentNode);
-           
-        if(launch (scan_parse_code, scanIt, tempNode)<=0) flag--;
-    }
-    else if (strstr(t->tokenVal,"Print")!=NULL) {
-        flag++;
-        tempNode = buildTree( "<Out>","", parentNode);
-        if(launch (print_parse_code, scanIt, tempNode)<=0) flag--;
-    }  
-    else if (strstr(t->tokenVal,"[")!=NULL) {
-         //printf("iff  %s\n", t->tokenVal);
-        flag++;
-        tempNode = buildTree( "<If>","", parentNode);
-        if(launch (iff_parse_code, scanIt, tempNode)<=0) flag--;
-    }
-    else if (strstr(t->tokenVal,"Loop")!=NULL) {
-        //printf("loop %s\n", t->tokenVal);
-        flag++;
-        tempNode = buildTree( "<Loop>","", parentNode);
-        if(launch (loop_parse_code, scanIt, tempNode)<=0) flag--;
-    }
-    else if (strstr(t->tokenVal,"Begin")!=NULL) {
-        flag++;
-        tempNode = buildTree( "<block>","", parentNode);
-        tempNode->scope = parentNode->scope + 1;
-        if(launch (block_parse_code, scanIt, tempNode)<=0) flag--;
-    }
-    else if (t->tokenType==idCode ) {
-        flag++;
-        Treeptr assignNode;
-        assignNode = buildTree( "<assign>","", parentNode);
-        tempNode = buildTree( "<ID>", t->tokenVal, assignNode);
-        
-        //scope check routines 
-        char tempString[25];
-        int tempScope = tempNode->scope;
-        int foundVar = 0;
-        strcpy(tempString,tempNode->value );
-        for (tempScope; tempScope>=0; tempScope--){
-            if (scope_findDup (tempScope,string2int(tempString)) == 1) {
-                foundVar++;
-            }
-        }
-        if (foundVar== 0) {
-            printf("[ERROR] : Cannot find the [%s] variable in current scope [%d] and parent scope.\n", tempNode->value, tempNode->scope);
-            flag--;
+    //printf("stat %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
+    switch (c->kind) {
+        case scanKeyword:
+            flag++;
+            tempNode = buildTree(c, "<In>","", parentNode);
+            if(launch (scan_parse_code, c, tempNode)<=0) flag--;
+            break;
+        case printKeyword:
+            flag++;
+            tempNode = buildTree(c, "<Out>","", parentNode);
+            if(launch (print_parse_code, c, tempNode)<=0) flag--;
+            break;
+        case openBracketDelimiter:
+            //printf("iff  %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
+            flag++;
+            tempNode = buildTree(c, "<If>","", parentNode);
+            if(launch (iff_parse_code, c, tempNode)<=0) flag--;
+            break;
+        case loopKeyword:
+            //printf("loop %s\n", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)));
+            flag++;
+            tempNode = buildTree(c, "<Loop>","", parentNode);
+            if(launch (loop_parse_code, c, tempNode)<=0) flag--;
+            break;
+        case beginKeyword:
+            flag++;
+            tempNode = buildTree(c, "<block>","", parentNode);
+            tempNode->scope = parentNode->scope + 1;
+            if(launch (block_parse_code, c, tempNode)<=0) flag--;
+            break;
+        case identifierKind: {
+            flag++;
+            Treeptr assignNode;
+            assignNode = buildTree(c, "<assign>","", parentNode);
+            tempNode = buildIdTree(c, c->t->value, assignNode);
+            if(launch (assign_parse_code, c, assignNode)<=0) flag--;
+            break;
         }
-        //end scope check
-        
-        if(launch (assign_parse_code, scanIt, assignNode)<=0) flag--;
-    }
-    else if (strstr(t->tokenVal,"End")!=NULL) {
-        //if(launch (get_next_token, scanIt, tempNode)==0) flag--;
-    }
-    // if found no <stats>, issue syntax error because <stats> can't be empty per given grammar
-    else if (flag < 0)
-    {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing the body of <stat> block. \n", t->tokenLine-1);
+        case endKeyword:
+            //if(launch (get_next_token, c, tempNode)==0) flag--;
+            break;
+        case eofKind:
+            break;
+        default:
+            // no <stat> starts with this token: skip up to one that does, or <mStat> would never move on
+            syntaxError(c, "[ERROR : line %d] Incorrect syntax. Unexpected token in <stat> block. \n", c->t->line+1);
+            synchronize(c);
+            break;
     }
     return flag;
     
 }
 //<in>       ->      Scan : Identifier .
-int scan_parse (myScanner scanIt, Treeptr parentNode ) {
-    Treeptr tempNode;
+int scan_parse (myCompiler c, Treeptr parentNode ) {
+    Treeptr tempNode = NULL;
     int flag = 1;
     
-    if (strstr(t->tokenVal,":")!=NULL) {
-        if(launch (get_next_token, scanIt, parentNode)<=0) flag--;
+    if (c->kind==colonOperator) {
+        if(launch (get_next_token, c, parentNode)<=0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing ':'. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing ':'. \n", c->t->line+1);
         flag --;
     }
 
-    if (t->tokenType==idCode ) {
-        tempNode = buildTree( "<ID>", t->tokenVal, parentNode);
-        
-        //scope check routines 
-        char tempString[25];
-        strcpy(tempString,tempNode->value );
-        if (scope_findDup (tempNode->scope,string2int(tempString)) >= 1) {
-                fprintf(stderr, "[ERROR : line %d] Variable [%s] is already defined in scope [%d]. \n", t->tokenLine-1, tempNode->value, tempNode->scope);
-        }
-        //end scope check
-        
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (c->kind==identifierKind ) {
+        tempNode = buildIdTree(c, c->t->value, parentNode);
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing identifier. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing identifier. \n", c->t->line+1);
         flag --;
     }
     
-    if (strstr(t->tokenVal,".")!=NULL) {
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (c->kind==dotDelimiter) {
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing '.' \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing '.' \n", c->t->line+1);
         flag --;
     }
     
@@ -462,110 +500,107 @@ int scan_parse (myScanner scanIt, Treeptr parentNode ) {
         return 1;
 }
 //<out>      ->      Print [ <expr>  ] .
-int print_parse (myScanner scanIt, Treeptr parentNode ) {
-    Treeptr tempNode;
+int print_parse (myCompiler c, Treeptr parentNode ) {
+    Treeptr tempNode = NULL;
     int flag = 1;
-    if (strstr(t->tokenVal,"[")!=NULL) {
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (c->kind==openBracketDelimiter) {
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax in 'Print' function. Missing '['. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax in 'Print' function. Missing '['. \n", c->t->line+1);
         flag --;
     }
     
-    if (strstr(t->tokenVal,"-")!=NULL || strstr(t->tokenVal,"[")!=NULL || t->tokenType==idCode || t->tokenType==intCode) {
-        tempNode = buildTree( "<expr>", "",parentNode);
-        if(expr_parse(scanIt, tempNode)==0) flag--;
+    if (expr_first(c->kind)) {
+        if(expr_parse(c, parentNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax in 'Print' command. Missing <expr>. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax in 'Print' command. Missing <expr>. \n", c->t->line+1);
         flag --;
     }
     
-    if (strstr(t->tokenVal,"]")!=NULL) {
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (c->kind==closeBracketDelimiter) {
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax in 'Print' command. Missing ']'. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax in 'Print' command. Missing ']'. \n", c->t->line+1);
         flag --;
     }
     
-    if (strstr(t->tokenVal,".")!=NULL) {
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (c->kind==dotDelimiter) {
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax in 'Print' command. Missing '.' \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax in 'Print' command. Missing '.' \n", c->t->line+1);
         flag --;
     }
     return flag;
 }
 
 //<if>       ->      [ <expr> <RO> <expr> ]  Iff <block> 
-int iff_parse (myScanner scanIt, Treeptr parentNode ) {
-    Treeptr roNode,blockNode, tempNode;
-    roNode = buildTree( "<RO>","", parentNode);
-    blockNode = buildTree( "<block>","", parentNode);
+int iff_parse (myCompiler c, Treeptr parentNode ) {
+    Treeptr roNode,blockNode, tempNode = NULL;
+    roNode = buildTree(c, "<RO>","", parentNode);
+    blockNode = buildTree(c, "<block>","", parentNode);
     blockNode->scope = parentNode->scope + 1;
     int flag = 1;
     
                                                             //check for <expr>
-    if (t->tokenVal[0]=="-" || t->tokenVal[0] =="[" || t->tokenType==idCode || t->tokenType==intCode) {
-        tempNode = buildTree( "<expr>","", roNode);
-        if(expr_parse(scanIt, tempNode)==0) flag--;
+    if (expr_first(c->kind)) {
+        if(expr_parse(c, roNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing <expr>. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing <expr>. \n", c->t->line+1);
         flag --;
     }
                                                             //check for <RO>    
-    if (t->tokenType==relCode ) {
+    if (c->t->type==relCode ) {
         // need to record RO data here (greater, equal or something)
-        strcpy(roNode->value,t->tokenVal);
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+        lexemeCopy(c->tokens,c->t,roNode->value,sizeof(roNode->value));
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing relational symbol. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing relational symbol. \n", c->t->line+1);
         flag --;
     }   
                                                             //check for another <expr>
-    if (strstr(t->tokenVal,"-")!=NULL || strstr(t->tokenVal,"[")!=NULL || t->tokenType==idCode || t->tokenType==intCode) {
-        tempNode = buildTree( "<expr>","", roNode);
-        if(expr_parse(scanIt, tempNode)==0) flag--;
+    if (expr_first(c->kind)) {
+        if(expr_parse(c, roNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing <expr>. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing <expr>. \n", c->t->line+1);
         flag --;
     }
                                                             //check for ']'
-    if (strstr(t->tokenVal,"]")!=NULL) {
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (c->kind==closeBracketDelimiter) {
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing ']'. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing ']'. \n", c->t->line+1);
         flag --;
     }
                                                             //check for Iff
-    if (strstr(t->tokenVal,"Iff")!=NULL) {
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (c->kind==iffKeyword) {
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing 'Iff'. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing 'Iff'. \n", c->t->line+1);
         flag --;
     }
-    if (strstr(t->tokenVal,"Begin")!=NULL) {                            // if 'Begin' is found (no <vars> section)
-        if (launch (block_parse_code, scanIt, blockNode)==0) flag--;
+    if (c->kind==beginKeyword) {                            // if 'Begin' is found (no <vars> section)
+        if (launch (block_parse_code, c, blockNode)==0) flag--;
     } else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing <block>. \n", t->tokenLine);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing <block>. \n", c->t->line+1);
         flag--;
     }
     if (flag <= 0) return 0;
@@ -573,62 +608,60 @@ int iff_parse (myScanner scanIt, Treeptr parentNode ) {
         return 1;
 }            
 //<loop>     ->      Loop [ <expr> <RO> <expr> ] <block>
-int loop_parse (myScanner scanIt, Treeptr parentNode ) {
-    Treeptr roNode,blockNode, tempNode;
-    roNode = buildTree( "<RO>","", parentNode);
-    blockNode = buildTree( "<block>","", parentNode);
+int loop_parse (myCompiler c, Treeptr parentNode ) {
+    Treeptr roNode,blockNode, tempNode = NULL;
+    roNode = buildTree(c, "<RO>","", parentNode);
+    blockNode = buildTree(c, "<block>","", parentNode);
     blockNode->scope = parentNode->scope + 1;
     int flag = 1;
     
                                                             //check for <expr>
-    if (strstr(t->tokenVal,"-")!=NULL || strstr(t->tokenVal,"[")!=NULL || t->tokenType==idCode || t->tokenType==intCode) {
-        tempNode = buildTree( "<expr>","", roNode);
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
-        if(expr_parse(scanIt, tempNode)==0) flag--;
-        //if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (expr_first(c->kind)) {
+        if(launch (get_next_token, c, roNode)==0) flag--;
+        if(expr_parse(c, roNode)==0) flag--;
+        //if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing <expr> in left side of Loop . \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing <expr> in left side of Loop . \n", c->t->line+1);
         flag --;
     }
     
                                                             //check for <RO>    
-    if (t->tokenType==relCode ) {
+    if (c->t->type==relCode ) {
         //put relational codes here
-        strcpy(roNode->value,t->tokenVal);
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+        lexemeCopy(c->tokens,c->t,roNode->value,sizeof(roNode->value));
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing relational symbol. \n", t->tokenLine);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing relational symbol. \n", c->t->line+1);
         flag --;
     }   
                                                             //check for another <expr>
-    if (strstr(t->tokenVal,"-")!=NULL || strstr(t->tokenVal,"[")!=NULL || t->tokenType==idCode || t->tokenType==intCode) {
-        tempNode = buildTree( "<expr>","", roNode);
-        if(expr_parse(scanIt, tempNode)==0) flag--;
-        //if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (expr_first(c->kind)) {
+        if(expr_parse(c, roNode)==0) flag--;
+        //if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing <expr> in the right side of loop. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing <expr> in the right side of loop. \n", c->t->line+1);
         flag --;
     }
                                                             //check for ']'
-    if (strstr(t->tokenVal,"]")!=NULL) {
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (c->kind==closeBracketDelimiter) {
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing ']'. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing ']'. \n", c->t->line+1);
         flag --;
     }
-    if (strstr(t->tokenVal,"Begin")!=NULL) {                  // if 'Begin' is found (no <vars> section)
-        if (launch (block_parse_code, scanIt, blockNode)==0) flag--;
+    if (c->kind==beginKeyword) {                  // if 'Begin' is found (no <vars> section)
+        if (launch (block_parse_code, c, blockNode)==0) flag--;
     } else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing <block>. \n", t->tokenLine);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing <block>. \n", c->t->line+1);
         flag--;
     }
     if (flag <= 0) return 0;
@@ -637,35 +670,34 @@ int loop_parse (myScanner scanIt, Treeptr parentNode ) {
 }
 
 //<assign>   ->      Identifier == <expr> .                   // == is one token here
-int assign_parse (myScanner scanIt, Treeptr parentNode ) {
-    Treeptr tempNode;
+int assign_parse (myCompiler c, Treeptr parentNode ) {
+    Treeptr tempNode = NULL;
     int flag = 1;
-    if (strstr(t->tokenVal,"==")!=NULL) {
-        strcpy(parentNode->value,t->tokenVal);
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (c->kind==assignOperator) {
+        lexemeCopy(c->tokens,c->t,parentNode->value,sizeof(parentNode->value));
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing '=='. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing '=='. \n", c->t->line+1);
         flag --;
     }
     
-    if (strstr(t->tokenVal,"-")!=NULL || strstr(t->tokenVal,"[")!=NULL || t->tokenType==idCode || t->tokenType==intCode) {
-        tempNode = buildTree( "<expr>","", parentNode);
-        if(expr_parse(scanIt, tempNode)==0) flag--;
+    if (expr_first(c->kind)) {
+        if(expr_parse(c, parentNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing <expr> in <assign>. \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing <expr> in <assign>. \n", c->t->line+1);
         flag --;
     }
     
-    if (strstr(t->tokenVal,".")!=NULL) {
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+    if (c->kind==dotDelimiter) {
+        if(launch (get_next_token, c, tempNode)==0) flag--;
     }
     else
     {
-        fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing '.' \n", t->tokenLine-1);
+        syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing '.' \n", c->t->line+1);
         flag --;
     }
     if (flag <= 0) return 0;
@@ -674,151 +706,109 @@ int assign_parse (myScanner scanIt, Treeptr parentNode ) {
 }
 
 //<expr>     ->      <M> + <expr> | <M>
-//expr is a wrapper
-int expr_parse(myScanner scanIt, Treeptr parentNode ) {
-    Treeptr tempNode, mNode;
+//<M>        ->     <T> - <M> | <T>
+//<T>        ->      <F> * <T> | <F> / <T> | <F>
+//the three rules are parsed at once by precedence climbing (expr_climb) and the
+//tree holds one node per operator, no node per rule:
+//  <expr> : a binary operator (its value), the left and the right operands as children
+//  <neg>  : a unary minus, its operand as child
+//  <ID>, <INT> : the operands, [ <expr> ] leaves no node of its own
+//return 1 if success, 0 if there's an error
+int expr_parse(myCompiler c, Treeptr parentNode ) {
     int flag = 1;
-    mNode = buildTree( "<M>","", parentNode);
-    if(M_parse(scanIt, mNode)==1){
-        if(launch (get_next_token, scanIt, parentNode)==0) flag--;
-    }
-    else flag--;
-    
-    if (strstr(t->tokenVal,"+")!=NULL) {
-        strcpy(parentNode->value,t->tokenVal);
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
-        tempNode = buildTree( "<expr>","", parentNode);
-        if(expr_parse(scanIt, tempNode)==0) flag--;
-    }
-    
+    expr_climb(c, parentNode, plusPower, &flag);
     if (flag <= 0) return 0;
     else
-        return 1;    
+        return 1;
 }
 
-//<M>        ->     <T> - <M> | <T>
-int M_parse(myScanner scanIt, Treeptr parentNode ) {
-    //note that there are two M nodes in this block of codes
-    Treeptr tempNode,mNode;
-    int flag = 1;
-    tempNode = buildTree( "<T>","", parentNode);
-    if(T_parse(scanIt, tempNode)==1){
-        if(launch (get_next_token, scanIt, parentNode)==0) flag--;
-    }
-    else flag--;
-    
-    if (strstr(t->tokenVal,"-")!=NULL) {
-        strcpy(parentNode->value,t->tokenVal);
-        tempNode = buildTree( "<M>","", parentNode);
-        if(launch (get_next_token, scanIt, parentNode)==0) flag--;
-        if(M_parse(scanIt, tempNode)==0) flag--;
+//binding power of a binary operator of <expr>, 0 if the token is not one
+//+ binds the loosest, then -, then * and / (see <expr>, <M> and <T>)
+int expr_power (int tokenKind) {
+    switch (tokenKind) {
+        case plusOperator:
+            return plusPower;
+        case minusOperator:
+            return minusPower;
+        case timesOperator:
+        case divideOperator:
+            return timesPower;
+        default:
+            return 0;
     }
-    
-    if (flag <= 0) return 0;
-    else
-        return 1;    
 }
-//<T>        ->      <F> * <T> | <F> / <T> | <F>
-int T_parse(myScanner scanIt, Treeptr parentNode ) {
-    Treeptr tempNode,fNode;
-    fNode = buildTree( "<F>","", parentNode);
-    int flag = 1;
 
-    if(F_parse(scanIt, fNode)==1){
-        if(launch (get_next_token, scanIt, parentNode)==0) flag--;
-    }
-    else flag--;
-    
-    if (strstr(t->tokenVal,"*")!=NULL || strstr(t->tokenVal,"/")!=NULL) {
-        strcpy(parentNode->value,t->tokenVal);
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
-        tempNode = buildTree( "<T>","", parentNode);
-        if(T_parse(scanIt, tempNode)==0) flag--;
-    }
-    
-    if (flag <= 0) return 0;
-    else
-        return 1;    
+//an operand, then every operator binding at least as tight as power
+//the operand right before an operator moves under the operator node, and the right
+//operand is climbed with the same power: a - b - c is a - [ b - c ], as in the CFG
+//return the node of the expression, NULL if none was built
+Treeptr expr_climb(myCompiler c, Treeptr parentNode, int power, int *flag ) {
+    Treeptr left, opNode;
+    int opPower;
+    left = F_parse(c, parentNode, flag);
+    while ((opPower = expr_power(c->kind)) >= power && opPower > 0) {
+        opNode = adoptTree(c, "<expr>", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)), parentNode, left);
+        launch (get_next_token, c, opNode);
+        expr_climb(c, opNode, opPower, flag);
+        left = opNode;
+    }
+    return left;
 }
-//<F>        ->      - <F> | <R>
-int F_parse(myScanner scanIt, Treeptr parentNode ) {
-    Treeptr tempNode;
-    int flag = 1;
 
-    if (strstr(t->tokenVal,"-")!=NULL) {
-        strcpy(parentNode->value,t->tokenVal);
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
-        tempNode = buildTree( "<F>","", parentNode);        
-        if(F_parse(scanIt, tempNode)==0) flag--;
-    } else {
-        tempNode = buildTree( "<R>","", parentNode);
-        if(R_parse(scanIt, tempNode)==0) flag--;
-    }
-    
-    if (flag <= 0) return 0;
-    else
-        return 1;    
+//<F>        ->      - <F> | <R>
+//return the node of the operand, NULL if none was built
+Treeptr F_parse(myCompiler c, Treeptr parentNode, int *flag ) {
+    Treeptr negNode = NULL, tempNode;
+    while (c->kind==minusOperator) {
+        tempNode = buildTree(c, "<neg>", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)), parentNode);
+        if (negNode == NULL) negNode = tempNode;
+        parentNode = tempNode;
+        launch (get_next_token, c, parentNode);
+    }
+    tempNode = R_parse(c, parentNode, flag);
+    return (negNode != NULL) ? negNode : tempNode;
 }
+
 //<R>        ->      [ <expr> ] | Identifier | Number   
-int R_parse(myScanner scanIt, Treeptr parentNode ) {
-    Treeptr tempNode;
-    int flag = 1;
-    if (t->tokenType==idCode) {
-        tempNode = buildTree( "<ID>", t->tokenVal, parentNode);
-        
-        //scope check routines 
-        char tempString[25];
-        int tempScope = tempNode->scope;
-        int foundVar = 0;
-        strcpy(tempString,tempNode->value);
-        while (tempScope>=0){
-            foundVar = foundVar + scope_findDup (tempScope,string2int(tempString));
-            //printf("%d in scope %d \n", foundVar, tempScope);
-            tempScope--;
-        }
-        if (foundVar == 0) {
-                printf("[ERROR] : Cannot find the [%s] variable in current scope [%d] and parent scopes.\n", tempNode->value, tempNode->scope);
-                flag--;
-        }
-        //end scope check
-        
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
-    }else if (t->tokenType==intCode) {
-        tempNode = buildTree( "<INT>", t->tokenVal, parentNode);
-        if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+//return the node of the operand, NULL if none was built
+Treeptr R_parse(myCompiler c, Treeptr parentNode, int *flag ) {
+    Treeptr tempNode = NULL;
+    if (c->kind==identifierKind) {
+        tempNode = buildIdTree(c, c->t->value, parentNode);
+        launch (get_next_token, c, tempNode);
+    }else if (c->kind==integerKind) {
+        tempNode = buildTree(c, "<INT>", lexemeCopy(c->tokens,c->t,c->tokenText,sizeof(c->tokenText)), parentNode);
+        launch (get_next_token, c, tempNode);
     }
     else {
-        if (strstr(t->tokenVal,"[")!=NULL) {
-            if(launch (get_next_token, scanIt, parentNode)==0) flag--;
+        if (c->kind==openBracketDelimiter) {
+            launch (get_next_token, c, parentNode);
         }
         else
         {
-            fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing '['. \n", t->tokenLine-1);
-            flag --;
+            syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing '['. \n", c->t->line+1);
+            (*flag)--;
         }
         
-        if (strstr(t->tokenVal,"-")!=NULL || strstr(t->tokenVal,"[")!=NULL || t->tokenType==idCode || t->tokenType==intCode) {
-            tempNode = buildTree( "<expr>","", parentNode);
-            if(expr_parse(scanIt, tempNode)==0) flag--;
+        if (expr_first(c->kind)) {
+            tempNode = expr_climb(c, parentNode, plusPower, flag);
         }
         else
         {
-            fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing <expr> in <R>. \n", t->tokenLine-1);
-            flag --;
+            syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing <expr> in <R>. \n", c->t->line+1);
+            (*flag)--;
         }
         
-        if (strstr(t->tokenVal,"]")!=NULL) {
-            if(launch (get_next_token, scanIt, tempNode)==0) flag--;
+        if (c->kind==closeBracketDelimiter) {
+            launch (get_next_token, c, parentNode);
         }
         else
         {
-            fprintf(stderr, "[ERROR : line %d] Incorrect syntax. Missing ']'. \n", t->tokenLine-1);
-            flag --;
+            syntaxError(c, "[ERROR : line %d] Incorrect syntax. Missing ']'. \n", c->t->line+1);
+            (*flag)--;
         }
     }
-    if (flag <= 0) return 0;
-    else
-        return 1;    
+    return tempNode;
 }
 
 //************************
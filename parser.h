@@ -21,7 +21,9 @@
 //************************
 // FUNCTION PROTOTYPES
 
-void parser ( myScanner scanIt , Treeptr aTree);
-int launch (int code, myScanner scanIt, Treeptr parent_node );
+void parser ( myCompiler c );
+void parseTokens ( myCompiler c );             // parser without opening c->tokens, see parallelParser.c
+int parseBlock ( myCompiler c, Treeptr blockNode );
+int launch (int code, myCompiler c, Treeptr parent_node );
 
 #endif
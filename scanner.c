@@ -8,9 +8,14 @@
  Summary	 : Implementation of scanner ADT's functions. ADT definition and
                 implementation is in scanner.h
  Functions	 : myScanner initScanner ()
-                printDriverTable (myScanner source)
+                printDriverTable ()
                 myScanner scanByStream(FILE *fp)
+                int readBlock(myScanner s)
+                int loadSource (int fd, myScanner s)
                 myScanner scanByName(const char *filename)
+                myScanner scanByBuffer(const char *src, long len)
+                myScanner useEngine(myScanner s, int engine)
+                myScanner useThreads(myScanner s, int threads)
                 void clearScanner(myScanner s)
                 
  ============================================================================
@@ -19,8 +24,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 #include "./scanner.h"
+#include "./token.h"
+#include "./driverTable.h"
 
 //define implicit file ext here
 static const char fileExt[10] = ".fs16";
@@ -31,7 +43,8 @@ static const char fileExt[10] = ".fs16";
  *      initScanner
  * Description: 
  *      Allocate memory needed for the scanner ADt
- *      Populate the driver table with default values
+ *      The driver table is not built here: it is generated at build time
+ *      (see genDriver.c) and shared by all scanners.
  *      Please refer to README.md for details regarding
  *      automaton and mapped driver table.
  * Input:
@@ -44,73 +57,21 @@ myScanner initScanner () {
     myScanner    s;
     // allocate memory for scanner
 	s = malloc(sizeof(struct Scanner));
-    
-    //HARD CODE DRIVER TABLE HERE
-    
-    //step 1 - filling table with ERROR code "980"
-    int i,j;
-    for (i = 0; i<16; i++){                             // 16 rows - 16 states
-        for (j = 0; j<24; j++) {                        // 24 columns - 24 sets of values
-            s->table[i][j] = invalidToken_errorCode;
-        }
-    }
-    //step 2 - filling in TOKEN codes (defined in token.h file)
-    for (i=2; i<24; i++) s->table[1][i] = idCode;       //991 : Identifier Token
-    for (i = 0; i<16; i++){         
-        for (j = 0; j<24; j++) {        
-            //Fill the "Relational" token code
-            if (i==2 || i==4 || i==5 || i==7 || i==8 || i==10 ){
-                if (j==0 || j==1 || j==2 || (j>=8 && j<=13) ||j==15 ||j==18 ||j==21 ){
-                    s->table[i][j] = relCode;           //992 : Relational Token
-                }
-            }
-            //Fill the "Other" token code
-            if (i==11){
-                if (j==0 || j==1 || j==2 ||(j>=8 && j<=13) ||j==15 ||j==18 ||j==21 ){
-                    s->table[i][j] = otherCode;       //993 : Other Token
-                }
-            }
-            if (i==12){
-                if (j==0 || j==1 || j==2 || j==15 ||j==18 ||j==21 ){
-                    s->table[i][j] = otherCode;       //993 : Other Token
-                }
-            }
-            //Fill the "Delimiter" token code
-            if (i==13){
-                if (j==0 || j==1 || j==2 || (j>=8 && j<=13)) {
-                    s->table[i][j] = delimCode;       //994 : Delimiter Token
-                }
-            }
-            //Fill the "Integer" token code
-            if (i==14){
-                if ((j>=2 && j<=5) || (j>=8 && j<=13) || (j>=15 && j<=22)) {
-                    s->table[i][j] = intCode;       //995 : Integer Token
-                }
-            }
-            //Fill in the "Comment" token code
-            s->table[15][2] = comCode;      //995 : Comment token
-        }
-        s->table[i][24] = invalidCharacter_errorCode;  // fill col 24 with invalidCharacter_errorCode 
-    }
-    
-    //step 3 - filling in STATE codes (in asscending state code order)
-    s->table[0][2] = 0;
-    s->table[0][0] = s->table[1][0] = s->table[1][1] = 1;
-    s->table[0][3] = 2;
-    s->table[2][6] = 3;
-    s->table[3][3] = 4;
-    s->table[0][4] = 5;
-    s->table[5][3] = 6;
-    s->table[6][4] = 7;
-    s->table[0][5] = 8;
-    s->table[8][3] = 9;
-    s->table[9][5] = 10;
-    s->table[2][3] = 11;
-    for (i = 7; i<14; i++) s->table[0][i] = 12;
-    for (i = 14; i<23; i++) s->table[0][i] = 13;
-    s->table[0][1] = s->table[14][1] = 14;
-    s->table[0][23] = s->table[15][0] = s->table[15][1] = 15;
-    for (i = 3; i<24; i++) s->table[15][i] = 15;
+	s->fd = -1;
+	s->src = NULL;
+	s->srcLen = 0;
+	s->srcPos = 0;
+	s->srcBase = 0;
+	s->srcEnd = 0;
+	s->srcMapped = 0;
+	s->engine = tableEngine;
+	s->threads = 1;
+	s->quiet = 0;
+	s->intern = 1;
+	s->symbols = newStringTable();
+	s->line = 0;
+	s->lineFlag = 0;
+	s->messages = NULL;
     
     return s;
     
@@ -121,26 +82,32 @@ myScanner initScanner () {
  *      printDriverTable
  * Description:
  *      This function is for troubleshooting purpose. 
- *      It prints the currenet hardcoded driver table out to the screen.
+ *      It prints the compact driver table shared by all scanners
+ *      out to the screen, followed by the character class of each
+ *      printable ascii character.
  *      By defailt, this function is not available publicly.
  * Input:
- *      A scanner ADT
+ *      none
  * Output:
- *      Printing out corresponding scanner ADT's driver table
+ *      Printing out the scanners' driver table
  *****************/
-void printDriverTable (myScanner source) {
+void printDriverTable () {
     int i,j;
-    for (i = 0; i<16; i++){             // 16 rows - 16 states
+    for (i = 0; i<driverStates; i++){
     printf("\n");
-        for (j = 0; j<24; j++) {        // 24 columns - 24 sets of values
-            if (source->table[i][j] == invalidToken_errorCode){
+        for (j = 0; j<driverClasses; j++) {
+            if (driverTable[i][j] >= driverFinal && driverCode(driverTable[i][j]) == invalidToken_errorCode){
                 printf("    .");        // for presentation purpose
             }
+            else if (driverTable[i][j] >= driverFinal)
+                printf("%5i",driverCode(driverTable[i][j]));
             else 
-                printf("%5i",source->table[i][j]);
+                printf("%5i",driverTable[i][j]);
         }
     } 
     printf("\n");
+    for (i = 32; i<127; i++) printf("%c:%d ", i, charClass[i]);
+    printf("\n");
     
 }
 
@@ -150,6 +117,8 @@ void printDriverTable (myScanner source) {
  *      scanByStream
  * Description: 
  *      Create a scanner pointer pointed to stdin (a file redirection stream or a keyboard stream).
+ *      The stream is read block by block (see readBlock), the scanner
+ *      starts with an empty block.
  * Input:
  *      stdin
  * Output:
@@ -158,22 +127,109 @@ void printDriverTable (myScanner source) {
 myScanner scanByStream(FILE *fp)
 {
     myScanner a;
-    a = initScanner();
 	if (fp == NULL) {
 	    fprintf (stderr,"ERROR: Content stream is empty \n");
 	    return NULL;
     }
-	a->fp = fp;	
+    a = initScanner();
+	a->fd = fileno(fp);
+	a->src = malloc(blockSize);
 
 	return a;
 }
 
+/*****************
+ * Function:
+ *      readBlock
+ * Description: 
+ *      Read the next block of a stream scanner into its buffer, replacing
+ *      the block that was just consumed. Reading stops for good at the end
+ *      of the stream or on a read error.
+ * Input:
+ *      a scanner ADT
+ * Output:
+ *      1 if a new block is ready, 0 at the end of the stream (or for a
+ *      scanner that holds the whole source)
+ *****************/
+int readBlock(myScanner s)
+{
+    ssize_t n;
+    if (s->fd < 0 || s->srcEnd == 1) return 0;
+    do {
+        n = read(s->fd, (char *) s->src, blockSize);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+        s->srcEnd = 1;
+        return 0;
+    }
+    s->srcBase += s->srcLen;
+    s->srcLen = n;
+    s->srcPos = 0;
+    return 1;
+}
+
+/*****************
+ * Function:
+ *      loadSource
+ * Description:
+ *      This function is internal to the ADT.
+ *      Bring the whole content of an opened file into memory.
+ *      The file is memory-mapped when possible; if it cannot be mapped
+ *      (pipes, special files...) it is read in one block instead.
+ * Input:
+ *      an opened file descriptor and a scanner ADT
+ * Output:
+ *      1 if the source buffer is ready, 0 if there is an error
+ *****************/
+int loadSource (int fd, myScanner s) {
+    struct stat st;
+    char *buffer, *grown;
+    long size, used = 0;
+    ssize_t n = 0;
+
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        buffer = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (buffer != MAP_FAILED) {
+            madvise(buffer, st.st_size, MADV_SEQUENTIAL);
+            s->src = buffer;
+            s->srcLen = st.st_size;
+            s->srcMapped = 1;
+            return 1;
+        }
+    }
+
+    //fall back to one block read, growing the buffer if the size is unknown
+    size = (fstat(fd, &st) == 0 && st.st_size > 0) ? st.st_size + 1 : 65536;
+    buffer = malloc(size);
+    while (buffer != NULL && (n = read(fd, buffer + used, size - used)) > 0) {
+        used += n;
+        if (used == size) {
+            size = size * 2;
+            grown = realloc(buffer, size);
+            if (grown == NULL) {                    // the block read so far is given up
+                free(buffer);
+                return 0;
+            }
+            buffer = grown;
+        }
+    }
+    if (buffer == NULL || n < 0) {
+        free(buffer);
+        return 0;
+    }
+    s->src = buffer;
+    s->srcLen = used;
+    return 1;
+}
+
 /*****************
  * Function:
  *      scanByName
  * Description: 
  *      Create a scanner pointer from file name.
  *      The file name extention is implicit (default is ".fs16")
+ *      The whole file is memory-mapped (or read in one block when it
+ *      cannot be mapped) and tokens are read straight from that buffer.
  * Input:
  *      a string of the file's name (read from CLI)
  * Output:
@@ -181,14 +237,92 @@ myScanner scanByStream(FILE *fp)
  *****************/
 myScanner scanByName(const char *filename)
 {
-	strcat (filename, fileExt);
-	FILE* filePtr = fopen (filename, "r");
+    myScanner a;
+	char *name = malloc(strlen(filename) + strlen(fileExt) + 1);   // the caller's name is left as it is
+	int fd;
+	strcpy (name, filename);
+	strcat (name, fileExt);
+	fd = open (name, O_RDONLY);
 	//if that is a bogus argument or file is not readable
-	if (filePtr == NULL){
-			fprintf (stderr,"ERROR: file '%s' does not exist or not readable \n", filename);
+	if (fd < 0){
+			fprintf (stderr,"ERROR: file '%s' does not exist or not readable \n", name);
+			free(name);
 			return NULL;
 	}
-	return scanByStream(filePtr);
+	a = initScanner();
+	if (loadSource(fd, a) == 0) {
+	    fprintf (stderr,"ERROR: file '%s' does not exist or not readable \n", name);
+	    close(fd);
+	    clearScanner(a);
+	    free(name);
+	    return NULL;
+	}
+	close(fd);                                  // a mapping stays valid after close
+	free(name);
+
+	return a;
+}
+
+/*****************
+ * Function:
+ *      scanByBuffer
+ * Description: 
+ *      Create a scanner pointer from a source held in memory by the caller.
+ *      The source is copied into a buffer of the scanner.
+ * Input:
+ *      the source (not necessarily null terminated) and its length in bytes
+ * Output:
+ *      returning a scanner ADT, NULL if there is no source
+ *****************/
+myScanner scanByBuffer(const char *src, long len)
+{
+    myScanner a;
+	if (src == NULL || len < 0) {
+	    fprintf (stderr,"ERROR: Content buffer is empty \n");
+	    return NULL;
+    }
+	a = initScanner();
+	a->src = malloc(len + 1);                   // one more byte, so an empty source is not a NULL one
+	memcpy((char *) a->src, src, len);
+	a->srcLen = len;
+
+	return a;
+}
+
+/*****************
+ * Function:
+ *      useEngine
+ * Description: 
+ *      Pick the engine a newly constructed scanner will use to build tokens:
+ *      tableEngine (default) or directEngine. Both produce the same tokens.
+ * Input:
+ *      a scanner ADT (may be NULL) and an engine code
+ * Output:
+ *      the same scanner ADT
+ *****************/
+myScanner useEngine(myScanner s, int engine)
+{
+	if (s != NULL) s->engine = engine;
+	return s;
+}
+
+/*****************
+ * Function:
+ *      useThreads
+ * Description: 
+ *      Let a token stream scan the source of a newly constructed scanner
+ *      with several threads. The count is kept between 1 and maxThreads.
+ * Input:
+ *      a scanner ADT (may be NULL) and a number of threads
+ * Output:
+ *      the same scanner ADT
+ *****************/
+myScanner useThreads(myScanner s, int threads)
+{
+	if (threads < 1) threads = 1;
+	if (threads > maxThreads) threads = maxThreads;
+	if (s != NULL) s->threads = threads;
+	return s;
 }
 
 /*****************
@@ -205,6 +339,9 @@ void clearScanner(myScanner s)
 {
 	// de-allocate memory
 	if (s != NULL) {
+		if (s->srcMapped == 1) munmap((void *) s->src, s->srcLen);
+		else if (s->src != NULL) free((void *) s->src);
+		clearStringTable(s->symbols);
 		free(s);
 	}
 }
\ No newline at end of file
@@ -9,7 +9,9 @@
                 or from a stream of information. The ADT implementation is made
                 available globally so other ADT can reference to it.
                 An important feature of this ADT is the data table which dictate
-                how scanned data can be interpreted.
+                how scanned data can be interpreted. The table is generated at
+                build time (genDriver -> driverTable.h) and shared read-only by
+                every scanner.
  
  ============================================================================
  */
@@ -18,10 +20,37 @@
 #define _SCANNER_H_
 
 
+//configuration : scanner engines
+#define tableEngine (0)             // getToken interprets the driver table
+#define directEngine (1)            // direct-coded automaton (see driverDirect.h)
+
+//configuration : parallel scanning (see tokenStream.c)
+#define chunkMin (262144)           // smallest part of a source worth its own thread, in bytes
+#define maxThreads (64)
+
+//configuration : streams are read block by block
+#define blockSize (65536)
+
+#include "./stringTable.h"
+#include "./textBuffer.h"
+
 typedef struct Scanner *myScanner; 
 struct Scanner {
-	FILE   *fp;				        // input stream
-    int     table[100][100];        // table max value is 100 for each dimension
+	int     fd;                     // stream read block by block, -1 when src holds the whole source
+    const char *src;                // whole source held in memory (mapped or read in one block), or the current block
+    long    srcLen;                 // number of bytes in src
+    long    srcPos;                 // read cursor into src
+    long    srcBase;                // position of src[0] in the source
+    int     srcEnd;                 // 1 once the stream has no more blocks
+    int     srcMapped;              // 1 if src is mmap'ed, 0 if it was malloc'ed
+    int     engine;                 // tableEngine or directEngine
+    int     threads;                // threads a token stream may use to scan the source
+    int     quiet;                  // 1 if scanner errors are reported by the caller, not printed
+    int     intern;                 // 1 if identifiers are interned as they are scanned (see stringTable.h)
+    myStringTable symbols;          // identifiers of the source, owned by the scanner
+    int     line;                   // lines counted so far
+    int     lineFlag;               // new lines seen but not counted yet, until the next token is accepted
+    myTextBuffer messages;          // scanner errors go here instead of stderr when set (not owned)
 };
 
 
@@ -34,6 +63,8 @@ struct Scanner {
  * Description: 
  *      Create a scanner pointer from file name.
  *      The file name extention is implicit (default is ".fs16")
+ *      The whole file is memory-mapped (or read in one block when it
+ *      cannot be mapped) and tokens are read straight from that buffer.
  * Input:
  *      a string of the file's name (read from CLI)
  * Output:
@@ -42,11 +73,30 @@ struct Scanner {
 myScanner scanByName(const char *filename);
 
 
+/*****************
+ * Function:
+ *      scanByBuffer
+ * Description: 
+ *      Create a scanner pointer from a source held in memory by the caller.
+ *      The source is copied, so the caller's buffer may go away at once;
+ *      no file is opened.
+ * Input:
+ *      the source (not necessarily null terminated) and its length in bytes
+ * Output:
+ *      returning a scanner ADT, NULL if there is no source
+ *****************/
+myScanner scanByBuffer(const char *src, long len);
+
+
 /*****************
  * Function:
  *      scanByStream
  * Description: 
  *      Create a scanner pointer pointed to stdin (a file redirection stream or a keyboard stream).
+ *      The stream is read with read(2), one block of blockSize bytes at a
+ *      time, so any input is scanned in constant memory. A token may span
+ *      two blocks: the scanner keeps its state and the partial token while
+ *      the next block is read.
  * Input:
  *      stdin
  * Output:
@@ -55,6 +105,52 @@ myScanner scanByName(const char *filename);
 myScanner scanByStream(FILE *fp);
 
 
+/*****************
+ * Function:
+ *      readBlock
+ * Description: 
+ *      Read the next block of a stream scanner into its buffer.
+ *      Used by the scanner once the current block is consumed.
+ * Input:
+ *      a scanner ADT
+ * Output:
+ *      1 if a new block is ready, 0 at the end of the stream (or for a
+ *      scanner that holds the whole source)
+ *****************/
+int readBlock(myScanner s);
+
+
+/*****************
+ * Function:
+ *      useEngine
+ * Description: 
+ *      Pick the engine a newly constructed scanner will use to build tokens:
+ *      tableEngine (default) or directEngine. Both produce the same tokens.
+ *      Meant to wrap a constructor, e.g. useEngine(scanByName(name), directEngine)
+ * Input:
+ *      a scanner ADT (may be NULL) and an engine code
+ * Output:
+ *      the same scanner ADT
+ *****************/
+myScanner useEngine(myScanner s, int engine);
+
+
+/*****************
+ * Function:
+ *      useThreads
+ * Description: 
+ *      Let a token stream scan the source of a newly constructed scanner
+ *      with several threads (see tokenStream.h). Only sources held in memory
+ *      are scanned in parallel; the tokens are the same as with one thread.
+ *      Meant to wrap a constructor, e.g. useThreads(scanByName(name), 4)
+ * Input:
+ *      a scanner ADT (may be NULL) and a number of threads
+ * Output:
+ *      the same scanner ADT
+ *****************/
+myScanner useThreads(myScanner s, int threads);
+
+
 /*****************
  * Function:
  *      clearScanner
@@ -6,88 +6,308 @@
  Version     : 1
  Copyright   : (CC)
  Summary	 : checking scopes of blocks and variables in a successfully built BSTree
- Functions	 :
+ Functions	 : void scope_print (myCompiler c)
+                void addError (struct ScopeErrors *errors, Treeptr node, int kind, int job)
+                int isJob (struct ScopeWalk *sw, Treeptr node)
+                int checkEnter (void *state, Treeptr node, int level)
+                void checkExit (void *state, Treeptr node, int level)
+                void walkScopes (myScopeTable scopes, myScopeTable outer, Treeptr root,
+                                 struct ScopeErrors *errors, struct ScopeJobs *js)
+                void *checkJobs (void *arg)
+                void runChecks (myCompiler c, struct ScopeJobs *js)
+                int reportErrors (myCompiler c, struct ScopeErrors *errors, struct ScopeJobs *js)
+                int scope_checkTree (myCompiler c)
  ============================================================================
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
 #include "./scopeCheck.h"
+#include "./visitor.h"
 
-//note that we have these arrays
-int scopes[100] = {0};
-int scopeMembers[100] = {0};
+//the variables of the open scopes are kept in the scope table of the context
+//(see scopeTable.h), the threads have one each
 
+//kinds of scope errors
+#define conflictFirst (0)           // the first variable of a <vars> is declared twice in its scope
+#define conflictMore (1)            // one of the next variables of a <vars>
+#define undeclaredWritten (2)       // a variable of an <In>, or the target of an <assign>, is not declared
+#define undeclaredRead (3)          // any other variable not declared
+#define jobErrors (4)               // the errors of a block checked by the threads go here
 
-int length = sizeof(scopeMembers) / sizeof(int);
+//a scope error found, reported once every block is checked
+struct ScopeError {
+    Treeptr node;                   // its <ID> node
+    int kind;
+    int job;                        // jobErrors : the block
+};
 
-int scope_get_begin_index (int scope) {
-    int temp=0;
-    if (scope==0) temp = 0;
-    else {    
-       while (scope>=0){
-         scope--;
-         temp += scopes[scope];
-       }
-           //temp--;
+struct ScopeErrors {
+    struct ScopeError *list;        // in source order
+    int count, room;
+};
+
+//a block left to the threads
+struct ScopeJob {
+    Treeptr node;                   // its <block> node
+    struct ScopeErrors errors;
+};
+
+struct ScopeJobs {
+    struct ScopeJob *list;          // blocks in source order
+    int count, room;
+    myScopeTable enclosing;         // copy of the scopes enclosing the blocks, only read by the threads
+    int next;                       // next block for a thread
+    pthread_mutex_t lock;           // guards next
+};
+
+//one thread, with a scope table of its own
+struct ScopeWorker {
+    struct ScopeJobs *js;
+    pthread_t thread;
+    int started;
+};
+
+
+//print the symbol IDs of the open scopes, the program first
+void scope_print (myCompiler c) {
+    myScopeTable t = c->scopes;
+    int depth, i;
+    for (depth = 0; depth<=t->depth; depth++) {
+        printf(" | ");
+        for (i = t->opened[depth]; i<((depth < t->depth) ? t->opened[depth + 1] : t->nEntries); i++) {
+            printf("%d ", t->entries[i].symbol);
+        }
     }
-    
-    return temp;
+    printf("\n");
 }
 
-int scope_get_end_index (int scope) {
-    int temp;
-    if (scopes[scope]==0) temp = 0;
-    else {
-        temp = scope_get_begin_index(scope) + scopes[scope];
+//keep an error, or the place of the errors of a block
+static void addError (struct ScopeErrors *errors, Treeptr node, int kind, int job) {
+    if (errors->count == errors->room) {
+        errors->room = (errors->room > 0) ? errors->room * 2 : 16;
+        errors->list = realloc(errors->list, errors->room * sizeof(struct ScopeError));
     }
+    errors->list[errors->count].node = node;
+    errors->list[errors->count].kind = kind;
+    errors->list[errors->count++].job = job;
+}
+
 
-    return temp;
+//a walk checking the scopes of a subtree
+struct ScopeWalk {
+    myScopeTable scopes;            // the table to declare in
+    myScopeTable outer;             // the scopes enclosing the subtree, NULL if the table has them
+    struct ScopeErrors *errors;
+    struct ScopeJobs *js;           // the blocks left to the threads, NULL to check them all
+};
+
+//1 if a node is a block left to the threads
+static int isJob (struct ScopeWalk *sw, Treeptr node) {
+    return sw->js != NULL && node->scope == checkScope && strcmp(node->data, "<block>") == 0;
 }
 
-int scope_add (int scope, int val) {
-    int temp=length;
-    int posTail = scope_get_end_index(scope);
-    int posStart = scope_get_begin_index(scope);
-    while (temp>posStart) {
-        // move all the back members one position away, to the right
-        scopeMembers[temp] = scopeMembers[temp-1];
-        temp--;
+//check the <ID> of a node, open the scope of a <block>; a block left to the
+//threads is not visited
+static int checkEnter (void *state, Treeptr node, int level) {
+    struct ScopeWalk *sw = state;
+    struct ScopeJobs *js = sw->js;
+    Treeptr parent = node->parent;
+    if (node->symbol != noSymbol && parent != NULL) {
+        if (strcmp(parent->data, "<vars>") == 0) {
+            if (declareSymbol(sw->scopes, node->symbol) == 0)
+                addError(sw->errors, node, (parent->children[0] == node) ? conflictFirst : conflictMore, -1);
+        } else if (lookupSymbol(sw->scopes, node->symbol) < 0 && (sw->outer == NULL || lookupSymbol(sw->outer, node->symbol) < 0)) {
+            if (strcmp(parent->data, "<In>") == 0 || (strcmp(parent->data, "<assign>") == 0 && parent->children[0] == node))
+                addError(sw->errors, node, undeclaredWritten, -1);
+            else addError(sw->errors, node, undeclaredRead, -1);
+        }
+    }
+    if (isJob(sw, node)) {
+        //every block nested in the main block sees the same scopes: the
+        //declarations of a block come before its statements
+        if (js->enclosing == NULL) js->enclosing = copyScopeTable(sw->scopes);
+        if (js->count == js->room) {
+            js->room = (js->room > 0) ? js->room * 2 : 64;
+            js->list = realloc(js->list, js->room * sizeof(struct ScopeJob));
+        }
+        js->list[js->count].node = node;
+        js->list[js->count].errors.list = NULL;
+        js->list[js->count].errors.count = js->list[js->count].errors.room = 0;
+        addError(sw->errors, node, jobErrors, js->count++);
+        return 0;
     }
-    scopes[scope]++;
-    scopeMembers[posStart]=val;
-    
+    if (strcmp(node->data, "<block>") == 0) openScope(sw->scopes);
     return 1;
 }
 
-void scope_print () {
-    int ctr = 0;
-    int begin, end;
-    
-    for (ctr; ctr <=100; ctr++)
-    {
-        if (scopes[ctr]>0){
-            begin = scope_get_begin_index(ctr);
-            end = scope_get_end_index(ctr);
-            printf(" | ");
-            for (begin; begin<end; begin++){
-                printf("%d ", scopeMembers[begin]);
-            }
-        }
+//close the scope of a <block> once its subtree is done
+static void checkExit (void *state, Treeptr node, int level) {
+    struct ScopeWalk *sw = state;
+    if (strcmp(node->data, "<block>") == 0 && !isJob(sw, node)) closeScope(sw->scopes);
+}
 
+
+/*****************
+ * Function:
+ *      walkScopes
+ * Description:
+ *      This function is internal to the ADT.
+ *      Check every <ID> node of a subtree in preorder (the order of the
+ *      source, see visitor.h): a <block> opens a scope until its subtree
+ *      is done, an <ID> of a <vars> is declared, the one of an <In> and the
+ *      first child of an <assign> are written, the others are read.
+ * Input:
+ *      the scope table to declare in, the scopes enclosing the subtree (read
+ *      only, NULL if the table has them), the root of the subtree, the
+ *      errors and the jobs: the blocks of scope checkScope are left to the
+ *      threads, unless the jobs are NULL
+ * Output:
+ *      the errors found, in source order
+ *****************/
+static void walkScopes (myScopeTable scopes, myScopeTable outer, Treeptr root,
+                        struct ScopeErrors *errors, struct ScopeJobs *js) {
+    struct ScopeWalk sw;
+    struct Visitor v = {checkEnter, NULL, checkExit, NULL};
+    sw.scopes = scopes;
+    sw.outer = outer;
+    sw.errors = errors;
+    sw.js = js;
+    v.state = &sw;
+    visitTree(root, 0, &v);
+}
+
+
+/*****************
+ * Function:
+ *      checkJobs
+ * Description:
+ *      This function is internal to the ADT.
+ *      Thread body: check blocks until none is left, each in a table of
+ *      the thread, the enclosing scopes looked up in the shared copy
+ * Input:
+ *      a worker
+ * Output:
+ *      the errors of the blocks checked
+ *****************/
+static void *checkJobs (void *arg) {
+    struct ScopeWorker *wk = arg;
+    struct ScopeJobs *js = wk->js;
+    myScopeTable scopes = newScopeTable();
+    int k;
+    for (;;) {
+        pthread_mutex_lock(&js->lock);
+        k = js->next++;
+        pthread_mutex_unlock(&js->lock);
+        if (k >= js->count) break;
+        emptyScopeTable(scopes);
+        walkScopes(scopes, js->enclosing, js->list[k].node, &js->list[k].errors, NULL);
     }
-    printf("\n");
-    return;
+    clearScopeTable(scopes);
+    return NULL;
+}
+
+
+/*****************
+ * Function:
+ *      runChecks
+ * Description:
+ *      This function is internal to the ADT.
+ *      Check the blocks on a pool of threads, the calling one included
+ * Input:
+ *      a compilation context ADT and its jobs
+ * Output:
+ *      the errors of every block
+ *****************/
+static void runChecks (myCompiler c, struct ScopeJobs *js) {
+    struct ScopeWorker workers[maxThreads];
+    int n = c->scanner->threads, k;
+
+    if (n > js->count) n = js->count;
+    pthread_mutex_init(&js->lock, NULL);
+    js->next = 0;
+    for (k = 0; k<n; k++) {
+        workers[k].js = js;
+        workers[k].started = (k > 0 && pthread_create(&workers[k].thread, NULL, checkJobs, &workers[k]) == 0);
+    }
+    checkJobs(&workers[0]);
+    for (k = 1; k<n; k++) {
+        if (workers[k].started) pthread_join(workers[k].thread, NULL);
+    }
+    pthread_mutex_destroy(&js->lock);
 }
 
-int scope_findDup (int scope, int val) {
-    int temp=0;
-    int posTail = scope_get_end_index(scope);
-    int posStart = scope_get_begin_index(scope);
-    
-    for (posStart; posStart<posTail; posStart++){
-        if (scopeMembers[posStart]==val) temp++;
+
+/*****************
+ * Function:
+ *      reportErrors
+ * Description:
+ *      This function is internal to the ADT.
+ *      Report the errors found, those of each block in its place
+ * Input:
+ *      a compilation context ADT, the errors of the main walk and the jobs
+ * Output:
+ *      the messages (see reportError), the number of errors
+ *****************/
+static int reportErrors (myCompiler c, struct ScopeErrors *errors, struct ScopeJobs *js) {
+    struct ScopeError *e;
+    int i, count = 0;
+    for (i = 0; i<errors->count; i++) {
+        e = &errors->list[i];
+        switch (e->kind) {
+            case jobErrors:
+                count += reportErrors(c, &js->list[e->job].errors, js);
+                break;
+            case conflictFirst:
+                reportError(c, stderr, "[ERROR - line %d] : There is a scope conflict. Value: %s\n", e->node->line+1, e->node->value);
+                count++;
+                break;
+            case conflictMore:
+                reportError(c, stderr, "[ERROR - line %d] : There is a scope conflict. Value: %s - Scope: %d\n",
+                        e->node->line+1, e->node->value, e->node->scope);
+                count++;
+                break;
+            default:
+                reportError(c, stdout, "[ERROR - line %d] : Cannot find the [%s] variable in current scope [%d] and parent scope%s.\n",
+                        e->node->line+1, e->node->value, e->node->scope, (e->kind == undeclaredWritten) ? "" : "s");
+                count++;
+        }
     }
-    
-    return temp;
+    return count;
+}
+
+
+/*****************
+ * Function:
+ *      scope_checkTree
+ * Description:
+ *      Check the tree of a compilation. The main walk leaves the blocks
+ *      nested in the main block to the threads, unless the tree is small
+ *      or there are no threads, then the errors are reported in order
+ * Input:
+ *      a compilation context ADT, with or without a tree
+ * Output:
+ *      the number of scope errors found
+ *****************/
+int scope_checkTree (myCompiler c) {
+    struct ScopeErrors errors = { NULL, 0, 0 };
+    struct ScopeJobs js;
+    int threads = (c->scanner != NULL) ? c->scanner->threads : 1, k, count;
+
+    emptyScopeTable(c->scopes);
+    if (c->tree == NULL) return 0;
+    js.list = NULL;
+    js.count = js.room = 0;
+    js.enclosing = NULL;
+    walkScopes(c->scopes, NULL, c->tree, &errors, (threads > 1 && c->labels >= checkMin) ? &js : NULL);
+    if (js.count > 0) runChecks(c, &js);
+    count = reportErrors(c, &errors, &js);
+
+    for (k = 0; k<js.count; k++) free(js.list[k].errors.list);
+    free(js.list);
+    clearScopeTable(js.enclosing);
+    free(errors.list);
+    return count;
 }
@@ -6,6 +6,16 @@
  Version     : 1
  Copyright   : (CC)
  Summary	 : checking scopes of blocks and variables in a successfully built BSTree
+                The parsers only build the tree; scope_checkTree is the
+                semantic pass made on it afterwards, skipped for trusted
+                sources (see trustedSource in compiler.h). A block opens a
+                scope: its variables are only seen inside it, and may shadow
+                the ones of enclosing scopes.
+                The blocks nested in the main block (checkScope) do not see
+                each other, so they are checked by a pool of threads, each
+                against a read-only copy of the scopes enclosing them. The
+                errors are reported in the order of the source, as a serial
+                check would.
  Functions	 :
  ============================================================================
  */
@@ -16,11 +26,33 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-extern int scopes[100];
-extern int scopeMembers[100];
+#include "./compiler.h"
+#include "./buildTree.h"
 
-int scope_add (int scope, int val);
-void scope_print ();
-int scope_findDup (int scope, int val);
+//configuration : scope of the blocks checked by the threads, the ones nested in the main block
+#define checkScope (2)
+//configuration : smallest tree worth the threads, in nodes
+#define checkMin (16384)
 
-#endif /* SCOPECHECK_H_ */
\ No newline at end of file
+//print the symbol IDs of the open scopes of a compilation, the program first
+void scope_print (myCompiler c);
+
+
+/*****************
+ * Function:
+ *      scope_checkTree
+ * Description:
+ *      Check every <ID> node of the tree of a compilation: a declaration
+ *      may not conflict with one of the same scope, a variable used has to
+ *      be declared in its scope or an enclosing one. The blocks nested in
+ *      the main block are checked on as many threads as the scanner allows
+ *      (see useThreads). The scope table is emptied first.
+ * Input:
+ *      a compilation context ADT, with or without a tree
+ * Output:
+ *      the number of scope errors found, reported in source order (see
+ *      reportError)
+ *****************/
+int scope_checkTree (myCompiler c);
+
+#endif /* SCOPECHECK_H_ */
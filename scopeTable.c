@@ -0,0 +1,165 @@
+/*
+ ============================================================================
+ Name        : scopeTable.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the scope table declared in scopeTable.h
+ Functions	 : myScopeTable newScopeTable ()
+                myScopeTable copyScopeTable (myScopeTable t)
+                void openScope (myScopeTable t)
+                void closeScope (myScopeTable t)
+                int declareSymbol (myScopeTable t, int symbol)
+                int lookupSymbol (myScopeTable t, int symbol)
+                int symbolEntry (myScopeTable t, int symbol)
+                void emptyScopeTable (myScopeTable t)
+                void clearScopeTable (myScopeTable t)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./scopeTable.h"
+
+
+/*****************
+ * Function:
+ *      newScopeTable
+ * Description:
+ *      Create a scope table with the scope of the program open, memory for
+ *      the symbols is only taken by the first declaration
+ * Input:
+ *      none
+ * Output:
+ *      a scope table ADT
+ *****************/
+myScopeTable newScopeTable () {
+    myScopeTable t = malloc(sizeof(struct ScopeTable));
+    t->innermost = NULL;
+    t->nSymbols = 0;
+    t->entriesCap = scopeEntries;
+    t->entries = malloc(t->entriesCap * sizeof(struct ScopeEntry));
+    t->nEntries = 0;
+    t->depthCap = scopeDepth;
+    t->opened = malloc(t->depthCap * sizeof(int));
+    t->opened[0] = 0;
+    t->depth = 0;
+    return t;
+}
+
+
+//a copy of a scope table, with the same scopes open and the same declarations
+myScopeTable copyScopeTable (myScopeTable t) {
+    myScopeTable copy = malloc(sizeof(struct ScopeTable));
+    *copy = *t;
+    copy->innermost = NULL;
+    if (t->nSymbols > 0) {
+        copy->innermost = malloc(t->nSymbols * sizeof(int));
+        memcpy(copy->innermost, t->innermost, t->nSymbols * sizeof(int));
+    }
+    copy->entries = malloc(t->entriesCap * sizeof(struct ScopeEntry));
+    memcpy(copy->entries, t->entries, t->nEntries * sizeof(struct ScopeEntry));
+    copy->opened = malloc(t->depthCap * sizeof(int));
+    memcpy(copy->opened, t->opened, (t->depth + 1) * sizeof(int));
+    return copy;
+}
+
+
+//open a scope inside the innermost one
+void openScope (myScopeTable t) {
+    if (t->depth + 1 == t->depthCap) {
+        t->depthCap *= 2;
+        t->opened = realloc(t->opened, t->depthCap * sizeof(int));
+    }
+    t->opened[++t->depth] = t->nEntries;
+}
+
+
+//close the innermost scope, its declarations give the shadowed ones back
+void closeScope (myScopeTable t) {
+    struct ScopeEntry *e;
+    if (t->depth == 0) return;
+    while (t->nEntries > t->opened[t->depth]) {
+        e = &t->entries[--t->nEntries];
+        t->innermost[e->symbol] = e->shadowed;
+    }
+    t->depth--;
+}
+
+
+/*****************
+ * Function:
+ *      declareSymbol
+ * Description:
+ *      Declare a variable in the innermost scope: the symbol ID indexes
+ *      its innermost declaration, so a conflict is one probe
+ * Input:
+ *      a scope table ADT and a symbol ID
+ * Output:
+ *      1 if declared, 0 if the innermost scope already declares it
+ *****************/
+int declareSymbol (myScopeTable t, int symbol) {
+    struct ScopeEntry *e;
+    int i;
+    if (symbol < 0) return 1;
+    if (symbol >= t->nSymbols) {                        // room for the symbol, the new ones are not declared
+        i = t->nSymbols;
+        t->nSymbols = (symbol + 1 > t->nSymbols * 2) ? symbol + 1 : t->nSymbols * 2;
+        t->innermost = realloc(t->innermost, t->nSymbols * sizeof(int));
+        for (; i<t->nSymbols; i++) t->innermost[i] = -1;
+    }
+    if (t->innermost[symbol] >= 0 && t->entries[t->innermost[symbol]].depth == t->depth) return 0;
+    if (t->nEntries == t->entriesCap) {
+        t->entriesCap *= 2;
+        t->entries = realloc(t->entries, t->entriesCap * sizeof(struct ScopeEntry));
+    }
+    e = &t->entries[t->nEntries];
+    e->symbol = symbol;
+    e->depth = t->depth;
+    e->shadowed = t->innermost[symbol];
+    t->innermost[symbol] = t->nEntries++;
+    return 1;
+}
+
+
+//the scope of the innermost declaration of a symbol, -1 if it is not declared
+int lookupSymbol (myScopeTable t, int symbol) {
+    if (symbol < 0 || symbol >= t->nSymbols || t->innermost[symbol] < 0) return -1;
+    return t->entries[t->innermost[symbol]].depth;
+}
+
+
+//the innermost declaration of a symbol in the entries, -1 if it is not declared
+int symbolEntry (myScopeTable t, int symbol) {
+    if (symbol < 0 || symbol >= t->nSymbols) return -1;
+    return t->innermost[symbol];
+}
+
+
+//forget every declaration, only the scope of the program stays open
+void emptyScopeTable (myScopeTable t) {
+    while (t->depth > 0) closeScope(t);
+    while (t->nEntries > 0) t->innermost[t->entries[--t->nEntries].symbol] = -1;
+}
+
+
+/*****************
+ * Function:
+ *      clearScopeTable
+ * Description:
+ *      free up memory used by a scope table ADT
+ * Input:
+ *      a scope table ADT (may be NULL)
+ * Output:
+ *      released memory previously occupied by the scope table ADT
+ *****************/
+void clearScopeTable (myScopeTable t) {
+    if (t == NULL) return;
+    free(t->innermost);
+    free(t->entries);
+    free(t->opened);
+    free(t);
+}
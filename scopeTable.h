@@ -0,0 +1,171 @@
+/*
+ ============================================================================
+ Name        : scopeTable.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Symbol table of the scopes. The variables declared in the open
+                scopes (the program, then each block the parser is in) are
+                kept on one stack of declarations, and each symbol ID (see
+                stringTable.h, where names are hashed to exact IDs) points
+                to its innermost declaration, which points to the one it
+                shadows. Declaring, looking up and resolving shadowing take
+                one probe; closing a scope pops its declarations and gives
+                the shadowed ones back. Every array grows when needed, there
+                is no limit on scopes nor on variables.
+
+ ============================================================================
+ */
+
+#ifndef _SCOPETABLE_H_
+#define _SCOPETABLE_H_
+
+//configuration : initial sizes, the arrays double when full
+#define scopeEntries (256)              // declarations of the open scopes
+#define scopeDepth (32)                 // open scopes
+
+//a declaration of a variable
+struct ScopeEntry {
+    int symbol;                     // symbol ID of the variable
+    int depth;                      // scope declaring it, 0 for the program
+    int shadowed;                   // declaration of the same symbol in an enclosing scope, -1 if none
+};
+
+typedef struct ScopeTable *myScopeTable;
+struct ScopeTable {
+    int *innermost;                 // symbol ID -> its innermost declaration in entries, -1 if none
+    int nSymbols;                   // room in innermost
+    struct ScopeEntry *entries;     // declarations of the open scopes, the innermost scope last
+    int nEntries;
+    int entriesCap;
+    int *opened;                    // opened[d] : nEntries when scope d was opened
+    int depth;                      // innermost open scope, 0 for the program
+    int depthCap;
+};
+
+
+/*****************
+ * Function:
+ *      newScopeTable
+ * Description:
+ *      Create a scope table with the scope of the program open
+ * Input:
+ *      none
+ * Output:
+ *      a scope table ADT
+ *****************/
+myScopeTable newScopeTable ();
+
+
+/*****************
+ * Function:
+ *      copyScopeTable
+ * Description:
+ *      Copy a scope table, e.g. to look variables up from several threads
+ *      while the table itself goes on changing
+ * Input:
+ *      a scope table ADT
+ * Output:
+ *      a new scope table ADT with the same scopes and declarations
+ *****************/
+myScopeTable copyScopeTable (myScopeTable t);
+
+
+/*****************
+ * Function:
+ *      openScope
+ * Description:
+ *      Open a scope inside the innermost one (a block starts)
+ * Input:
+ *      a scope table ADT
+ * Output:
+ *      none
+ *****************/
+void openScope (myScopeTable t);
+
+
+/*****************
+ * Function:
+ *      closeScope
+ * Description:
+ *      Close the innermost scope (a block ends): its variables are
+ *      forgotten and the ones they shadowed are seen again. The scope of
+ *      the program is never closed
+ * Input:
+ *      a scope table ADT
+ * Output:
+ *      none
+ *****************/
+void closeScope (myScopeTable t);
+
+
+/*****************
+ * Function:
+ *      declareSymbol
+ * Description:
+ *      Declare a variable in the innermost scope
+ * Input:
+ *      a scope table ADT and a symbol ID
+ * Output:
+ *      1 if declared, 0 if the innermost scope already declares it
+ *****************/
+int declareSymbol (myScopeTable t, int symbol);
+
+
+/*****************
+ * Function:
+ *      lookupSymbol
+ * Description:
+ *      Find the declaration of a variable seen from the innermost scope
+ * Input:
+ *      a scope table ADT and a symbol ID
+ * Output:
+ *      the scope declaring it (the innermost one), -1 if none does
+ *****************/
+int lookupSymbol (myScopeTable t, int symbol);
+
+
+/*****************
+ * Function:
+ *      symbolEntry
+ * Description:
+ *      Find the declaration of a variable seen from the innermost scope, as
+ *      its place in the declarations of the open scopes: the variables of
+ *      the open scopes are laid out as a stack, so the place is also a
+ *      storage slot (see storage.h)
+ * Input:
+ *      a scope table ADT and a symbol ID
+ * Output:
+ *      the index of the declaration in t->entries, -1 if none
+ *****************/
+int symbolEntry (myScopeTable t, int symbol);
+
+
+/*****************
+ * Function:
+ *      emptyScopeTable
+ * Description:
+ *      Forget every declaration and close every scope but the one of the
+ *      program, the memory is kept
+ * Input:
+ *      a scope table ADT
+ * Output:
+ *      an empty scope table
+ *****************/
+void emptyScopeTable (myScopeTable t);
+
+
+/*****************
+ * Function:
+ *      clearScopeTable
+ * Description:
+ *      free up memory used by a scope table ADT
+ * Input:
+ *      a scope table ADT (may be NULL)
+ * Output:
+ *      released memory previously occupied by the scope table ADT
+ *****************/
+void clearScopeTable (myScopeTable t);
+
+#endif
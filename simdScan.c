@@ -0,0 +1,263 @@
+/*
+ ============================================================================
+ Name        : simdScan.c
+ Author      : NGUYEN, TAM N
+ Created on  : 15OCT16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the vectorized run helpers declared in
+                simdScan.h. Each helper exists in a scalar, an SSE2 and an
+                AVX2 version; the AVX2 code is compiled for that target only
+                and is picked at run time when the processor supports it.
+ Functions	 : long blankScalar (const char *p, long n, long *newLines)
+                long alnumScalar (const char *p, long n)
+                long digitScalar (const char *p, long n)
+                long blankSSE2 / alnumSSE2 / digitSSE2
+                long blankAVX2 / alnumAVX2 / digitAVX2
+                int simdSelect (int level)
+                int simdLevel ()
+                long scanBlankRun (const char *p, long n, long *newLines)
+                long scanAlnumRun (const char *p, long n)
+                long scanDigitRun (const char *p, long n)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "./simdScan.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define simdX86 1
+#endif
+
+
+/*****************
+ * Scalar versions, also used for the tail of a buffer (less than one vector)
+ *****************/
+static inline int isDigitByte (unsigned char c) {
+    return (unsigned char) (c - '0') < 10;
+}
+
+static inline int isAlnumByte (unsigned char c) {
+    return (unsigned char) ((c | 0x20) - 'a') < 26 || isDigitByte(c);
+}
+
+static long blankScalar (const char *p, long n, long *newLines) {
+    long i = 0;
+    long lines = 0;
+    while (i < n && (p[i] == ' ' || p[i] == '\n')) {
+        if (p[i] == '\n') lines++;
+        i++;
+    }
+    *newLines = lines;
+    return i;
+}
+
+static long alnumScalar (const char *p, long n) {
+    long i = 0;
+    while (i < n && isAlnumByte(p[i])) i++;
+    return i;
+}
+
+static long digitScalar (const char *p, long n) {
+    long i = 0;
+    while (i < n && isDigitByte(p[i])) i++;
+    return i;
+}
+
+
+#ifdef simdX86
+/*****************
+ * SSE2 versions, 16 bytes per step.
+ * Bytes are compared as signed values: anything above 127 is negative and
+ * falls outside every range tested here.
+ *****************/
+static long blankSSE2 (const char *p, long n, long *newLines) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i newLine = _mm_set1_epi8('\n');
+    long i = 0;
+    long lines = 0;
+    long tail;
+    while (i + 16 <= n) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (p + i));
+        __m128i isNewLine = _mm_cmpeq_epi8(v, newLine);
+        unsigned blank = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, space), isNewLine));
+        unsigned lf = _mm_movemask_epi8(isNewLine);
+        if (blank != 0xFFFF) {                              // the run ends in this vector
+            unsigned len = __builtin_ctz(~blank);
+            *newLines = lines + __builtin_popcount(lf & ((1u << len) - 1));
+            return i + len;
+        }
+        lines += __builtin_popcount(lf);
+        i += 16;
+    }
+    i += blankScalar(p + i, n - i, &tail);
+    *newLines = lines + tail;
+    return i;
+}
+
+static inline __m128i inRangeSSE2 (__m128i v, char low, char high) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(low - 1)),
+                         _mm_cmpgt_epi8(_mm_set1_epi8(high + 1), v));
+}
+
+static long alnumSSE2 (const char *p, long n) {
+    long i = 0;
+    while (i + 16 <= n) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (p + i));
+        __m128i letter = inRangeSSE2(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z');
+        unsigned mask = _mm_movemask_epi8(_mm_or_si128(letter, inRangeSSE2(v, '0', '9')));
+        if (mask != 0xFFFF) return i + __builtin_ctz(~mask);
+        i += 16;
+    }
+    return i + alnumScalar(p + i, n - i);
+}
+
+static long digitSSE2 (const char *p, long n) {
+    long i = 0;
+    while (i + 16 <= n) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (p + i));
+        unsigned mask = _mm_movemask_epi8(inRangeSSE2(v, '0', '9'));
+        if (mask != 0xFFFF) return i + __builtin_ctz(~mask);
+        i += 16;
+    }
+    return i + digitScalar(p + i, n - i);
+}
+
+
+/*****************
+ * AVX2 versions, 32 bytes per step
+ *****************/
+__attribute__((target("avx2,popcnt")))
+static long blankAVX2 (const char *p, long n, long *newLines) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i newLine = _mm256_set1_epi8('\n');
+    long i = 0;
+    long lines = 0;
+    long tail;
+    while (i + 32 <= n) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (p + i));
+        __m256i isNewLine = _mm256_cmpeq_epi8(v, newLine);
+        unsigned blank = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), isNewLine));
+        unsigned lf = _mm256_movemask_epi8(isNewLine);
+        if (blank != 0xFFFFFFFFu) {                         // the run ends in this vector
+            unsigned len = __builtin_ctz(~blank);
+            *newLines = lines + __builtin_popcount(lf & ((1u << len) - 1));
+            return i + len;
+        }
+        lines += __builtin_popcount(lf);
+        i += 32;
+    }
+    i += blankScalar(p + i, n - i, &tail);
+    *newLines = lines + tail;
+    return i;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i inRangeAVX2 (__m256i v, char low, char high) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(low - 1)),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), v));
+}
+
+__attribute__((target("avx2")))
+static long alnumAVX2 (const char *p, long n) {
+    long i = 0;
+    while (i + 32 <= n) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (p + i));
+        __m256i letter = inRangeAVX2(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z');
+        unsigned mask = _mm256_movemask_epi8(_mm256_or_si256(letter, inRangeAVX2(v, '0', '9')));
+        if (mask != 0xFFFFFFFFu) return i + __builtin_ctz(~mask);
+        i += 32;
+    }
+    return i + alnumScalar(p + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static long digitAVX2 (const char *p, long n) {
+    long i = 0;
+    while (i + 32 <= n) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (p + i));
+        unsigned mask = _mm256_movemask_epi8(inRangeAVX2(v, '0', '9'));
+        if (mask != 0xFFFFFFFFu) return i + __builtin_ctz(~mask);
+        i += 32;
+    }
+    return i + digitScalar(p + i, n - i);
+}
+#endif
+
+
+//helpers in use, chosen once by simdSelect
+static long (*blankRun) (const char *, long, long *) = blankScalar;
+static long (*alnumRun) (const char *, long) = alnumScalar;
+static long (*digitRun) (const char *, long) = digitScalar;
+static int currentLevel = simdScalar;
+
+
+/*****************
+ * Function:
+ *      simdSelect
+ * Description:
+ *      Choose the instruction set used by the run helpers. The request is
+ *      lowered to what the processor supports.
+ * Input:
+ *      simdScalar, simdSSE2 or simdAVX2
+ * Output:
+ *      the instruction set actually in use
+ *****************/
+int simdSelect (int level) {
+    int best = simdScalar;
+#ifdef simdX86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) best = simdSSE2;
+    if (__builtin_cpu_supports("avx2")) best = simdAVX2;
+#endif
+    if (level > best) level = best;
+
+    blankRun = blankScalar;
+    alnumRun = alnumScalar;
+    digitRun = digitScalar;
+#ifdef simdX86
+    if (level == simdSSE2) {
+        blankRun = blankSSE2;
+        alnumRun = alnumSSE2;
+        digitRun = digitSSE2;
+    }
+    if (level == simdAVX2) {
+        blankRun = blankAVX2;
+        alnumRun = alnumAVX2;
+        digitRun = digitAVX2;
+    }
+#endif
+    currentLevel = level;
+    return currentLevel;
+}
+
+/*****************
+ * Function:
+ *      simdInit
+ * Description:
+ *      Pick the best instruction set once, when the program is loaded,
+ *      so the helpers never need to be resolved while scanning
+ *****************/
+__attribute__((constructor))
+static void simdInit () {
+    simdSelect(simdAVX2);
+}
+
+int simdLevel () {
+    return currentLevel;
+}
+
+long scanBlankRun (const char *p, long n, long *newLines) {
+    return blankRun(p, n, newLines);
+}
+
+long scanAlnumRun (const char *p, long n) {
+    return alnumRun(p, n);
+}
+
+long scanDigitRun (const char *p, long n) {
+    return digitRun(p, n);
+}
@@ -0,0 +1,97 @@
+/*
+ ============================================================================
+ Name        : simdScan.h
+ Author      : NGUYEN, TAM N
+ Created on  : 15OCT16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Vectorized helpers for the scanner. Most of a source is made of
+                long runs (indentation, identifier letters, digits, comments)
+                that keep the driver in the same state, so the scanner can
+                measure a whole run at once instead of stepping through it one
+                character at a time.
+                16 (SSE2) or 32 (AVX2) bytes are classified per step. The best
+                instruction set is picked at run time; a scalar version is used
+                on other processors.
+
+ ============================================================================
+ */
+
+#ifndef _SIMDSCAN_H_
+#define _SIMDSCAN_H_
+
+//configuration : instruction sets
+#define simdScalar (0)
+#define simdSSE2 (1)
+#define simdAVX2 (2)
+
+
+/*****************
+ * Function:
+ *      scanBlankRun
+ * Description:
+ *      Measure the run of white space (' ' and '\n') at the start of a buffer
+ *      and count the new lines in it
+ * Input:
+ *      a pointer into the source, the number of bytes available
+ *      and where to store the number of new lines
+ * Output:
+ *      the length of the run
+ *****************/
+long scanBlankRun (const char *p, long n, long *newLines);
+
+
+/*****************
+ * Function:
+ *      scanAlnumRun
+ * Description:
+ *      Measure the run of letters and digits at the start of a buffer
+ * Input:
+ *      a pointer into the source and the number of bytes available
+ * Output:
+ *      the length of the run
+ *****************/
+long scanAlnumRun (const char *p, long n);
+
+
+/*****************
+ * Function:
+ *      scanDigitRun
+ * Description:
+ *      Measure the run of digits at the start of a buffer
+ * Input:
+ *      a pointer into the source and the number of bytes available
+ * Output:
+ *      the length of the run
+ *****************/
+long scanDigitRun (const char *p, long n);
+
+
+/*****************
+ * Function:
+ *      simdSelect
+ * Description:
+ *      Choose the instruction set used by the run helpers. The request is
+ *      lowered to what the processor supports. Without a call, the best
+ *      supported instruction set is used.
+ * Input:
+ *      simdScalar, simdSSE2 or simdAVX2
+ * Output:
+ *      the instruction set actually in use
+ *****************/
+int simdSelect (int level);
+
+
+/*****************
+ * Function:
+ *      simdLevel
+ * Description:
+ *      Tell which instruction set the run helpers use
+ * Input:
+ *      none
+ * Output:
+ *      simdScalar, simdSSE2 or simdAVX2
+ *****************/
+int simdLevel ();
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ ============================================================================
+ Name        : storage.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the storage layout declared in storage.h
+ Functions	 : void declareSlot (struct LayoutState *l, int entry)
+                int layoutEnter (void *state, Treeptr node, int level)
+                void layoutExit (void *state, Treeptr node, int level)
+                int layoutStorage (myCompiler c)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./storage.h"
+#include "./visitor.h"
+
+
+//a storage layout being made
+struct LayoutState {
+    myCompiler c;
+    int *slotOf;                    // slotOf[e] : slot of the declaration e of the scope table
+    int room;                       // room in slotOf
+    int loops;                      // <Loop> nodes open
+    int next;                       // next slot of a declaration in a <Loop>
+};
+
+//the slot of a new declaration: its place on the stack, or a slot of its own
+//in a <Loop>, so it keeps its value from one turn of the loop to the next
+static void declareSlot (struct LayoutState *l, int entry) {
+    if (entry >= l->room) {
+        l->room = (entry + 1 > l->room * 2) ? entry + 1 : l->room * 2;
+        l->slotOf = realloc(l->slotOf, l->room * sizeof(int));
+    }
+    l->slotOf[entry] = (l->loops > 0) ? l->next++ : entry;
+    if (l->slotOf[entry] >= l->c->slots) l->c->slots = l->slotOf[entry] + 1;
+}
+
+//the slot of an <ID>, a <block> opens a scope, the outermost <Loop> starts
+//the slots of its body after the variables alive
+static int layoutEnter (void *state, Treeptr node, int level) {
+    struct LayoutState *l = state;
+    myCompiler c = l->c;
+    int entry;
+    if (node->symbol != noSymbol && node->parent != NULL) {
+        if (strcmp(node->parent->data, "<vars>") == 0 && declareSymbol(c->scopes, node->symbol))
+            declareSlot(l, c->scopes->nEntries - 1);    // a second declaration in a scope keeps the slot of the first
+        entry = symbolEntry(c->scopes, node->symbol);
+        node->slot = (entry < 0) ? -1 : l->slotOf[entry];
+    }
+    if (strcmp(node->data, "<block>") == 0) openScope(c->scopes);
+    if (strcmp(node->data, "<Loop>") == 0) {
+        if (l->loops++ == 0) l->next = c->scopes->nEntries;
+        node->slot = l->next;
+    }
+    return 1;
+}
+
+//a <block> closes its scope once its subtree is done, a <Loop> ends the
+//slots of its body
+static void layoutExit (void *state, Treeptr node, int level) {
+    struct LayoutState *l = state;
+    if (strcmp(node->data, "<block>") == 0) closeScope(l->c->scopes);
+    if (strcmp(node->data, "<Loop>") == 0) {
+        l->loops--;
+        node->slotsEnd = l->next;
+    }
+}
+
+
+/*****************
+ * Function:
+ *      layoutStorage
+ * Description:
+ *      Walk the tree in preorder (see visitor.h) with the scope table of
+ *      the context, as the scope checks do: a <block> opens a scope until
+ *      its subtree is done, an <ID> of a <vars> is declared, the others
+ *      are looked up.
+ *      The slot of an <ID> is the place of its declaration in the table,
+ *      the data section is the most declarations the table ever held. In
+ *      a <Loop>, the declarations take the slots after the variables alive
+ *      when the outermost one starts, one each, kept in the <Loop> node.
+ * Input:
+ *      a compilation context ADT, with or without a tree
+ * Output:
+ *      the number of slots, also in c->slots
+ *****************/
+int layoutStorage (myCompiler c) {
+    struct Visitor v = {layoutEnter, NULL, layoutExit, NULL};
+    struct LayoutState l;
+
+    emptyScopeTable(c->scopes);
+    c->slots = 0;
+    if (c->tree == NULL) return 0;
+    l.c = c;
+    l.room = storageSlots;
+    l.slotOf = malloc(l.room * sizeof(int));
+    l.loops = l.next = 0;
+    v.state = &l;
+    visitTree(c->tree, 0, &v);
+    free(l.slotOf);
+    emptyScopeTable(c->scopes);
+    return c->slots;
+}
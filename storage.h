@@ -0,0 +1,55 @@
+/*
+ ============================================================================
+ Name        : storage.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Storage of the variables, laid out at compile time as a stack
+                frame. The variables of the open scopes are a stack (see
+                scopeTable.h): a block pushes its declarations when it starts
+                and pops them when it ends, so a declaration is given the
+                slot of its place on that stack, and each use of a variable
+                the slot of the declaration it sees. Blocks that are not
+                nested in one another reuse the same slots, and the data
+                section of the ASM holds as many slots as the most variables
+                ever live at once (V0, V1, ...), not one per declaration.
+                A variable shadowing another one gets a slot of its own.
+                A slot may still hold a variable of a sibling block, so the
+                ASM stores 0 in it where its declaration is (the block
+                starts). A variable declared in a <Loop> keeps its value
+                from one turn to the next, as it does under its name: the
+                body of the outermost <Loop> does not share its slots, they
+                take the slots after the variables alive when it starts and
+                the ASM stores 0 in them once, before the loop.
+                Used with scopedStorage (see compiler.h), the variables are
+                stored under their names otherwise.
+
+ ============================================================================
+ */
+
+#ifndef _STORAGE_H_
+#define _STORAGE_H_
+
+#include "./compiler.h"
+#include "./buildTree.h"
+
+//configuration : declarations of the slots of a layout before it grows (doubled when full)
+#define storageSlots (64)
+
+/*****************
+ * Function:
+ *      layoutStorage
+ * Description:
+ *      Give a slot to every <ID> node of the tree of a compilation: the
+ *      slot of its declaration, -1 for a variable not declared (it keeps
+ *      its name). The scope table is emptied first.
+ * Input:
+ *      a compilation context ADT, with or without a tree
+ * Output:
+ *      the slots of the <ID> nodes and of the bodies of the <Loop> nodes,
+ *      c->slots the size of the data section in slots
+ *****************/
+int layoutStorage (myCompiler c);
+
+#endif
@@ -0,0 +1,180 @@
+/*
+ ============================================================================
+ Name        : stringTable.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the string table declared in stringTable.h
+ Functions	 : unsigned hashName (const char *text, int len)
+                void growSlots (myStringTable st)
+                myStringTable newStringTable ()
+                int internSymbol (myStringTable st, const char *text, int len)
+                const char *symbolName (myStringTable st, int id)
+                int symbolCount (myStringTable st)
+                void clearStringTable (myStringTable st)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./stringTable.h"
+
+/*****************
+ * Function:
+ *      hashName
+ * Description:
+ *      This function is internal to the table.
+ *      FNV-1a hash of a name
+ * Input:
+ *      the name and its length
+ * Output:
+ *      a hash value
+ *****************/
+static unsigned hashName (const char *text, int len) {
+    unsigned h = 2166136261u;
+    int i;
+    for (i = 0; i<len; i++) {
+        h ^= (unsigned char) text[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+
+/*****************
+ * Function:
+ *      growSlots
+ * Description:
+ *      This function is internal to the table.
+ *      Double the hash slots (or create them) and place every symbol again
+ * Input:
+ *      a string table ADT
+ * Output:
+ *      none
+ *****************/
+static void growSlots (myStringTable st) {
+    int i;
+    st->nSlots = (st->nSlots == 0) ? symbolSlots : st->nSlots * 2;
+    free(st->slots);
+    st->slots = calloc(st->nSlots, sizeof(int));
+    for (i = 0; i<st->nSymbols; i++) {
+        const char *name = st->names + st->nameAt[i];
+        unsigned h = hashName(name, strlen(name)) & (st->nSlots - 1);
+        while (st->slots[h] != 0) h = (h + 1) & (st->nSlots - 1);
+        st->slots[h] = i + 1;
+    }
+}
+
+
+/*****************
+ * Function:
+ *      newStringTable
+ * Description:
+ *      Create an empty string table, memory is only taken by the first name
+ * Input:
+ *      none
+ * Output:
+ *      a string table ADT
+ *****************/
+myStringTable newStringTable () {
+    myStringTable st = malloc(sizeof(struct StringTable));
+    st->slots = NULL;
+    st->nSlots = 0;
+    st->names = NULL;
+    st->namesLen = st->namesCap = 0;
+    st->nameAt = NULL;
+    st->nSymbols = st->symbolsCap = 0;
+    return st;
+}
+
+
+/*****************
+ * Function:
+ *      internSymbol
+ * Description:
+ *      Find the ID of a name, adding the name to the table the first time
+ * Input:
+ *      a string table ADT, the name (not necessarily null terminated) and its length
+ * Output:
+ *      the symbol ID of the name
+ *****************/
+int internSymbol (myStringTable st, const char *text, int len) {
+    unsigned h;
+    if (2 * (st->nSymbols + 1) > st->nSlots) growSlots(st);
+
+    h = hashName(text, len) & (st->nSlots - 1);
+    while (st->slots[h] != 0) {
+        const char *name = st->names + st->nameAt[st->slots[h] - 1];
+        if (strncmp(name, text, len) == 0 && name[len] == '\0') return st->slots[h] - 1;
+        h = (h + 1) & (st->nSlots - 1);
+    }
+
+    //a new name
+    if (st->nSymbols == st->symbolsCap) {
+        st->symbolsCap = (st->symbolsCap == 0) ? symbolSlots : st->symbolsCap * 2;
+        st->nameAt = realloc(st->nameAt, st->symbolsCap * sizeof(long));
+    }
+    while (st->namesLen + len + 1 > st->namesCap) {
+        st->namesCap = (st->namesCap == 0) ? symbolNames : st->namesCap * 2;
+        st->names = realloc(st->names, st->namesCap);
+    }
+    memcpy(st->names + st->namesLen, text, len);
+    st->names[st->namesLen + len] = '\0';
+    st->nameAt[st->nSymbols] = st->namesLen;
+    st->namesLen += len + 1;
+    st->slots[h] = st->nSymbols + 1;
+    return st->nSymbols++;
+}
+
+
+/*****************
+ * Function:
+ *      symbolName
+ * Description:
+ *      Give the name of a symbol ID
+ * Input:
+ *      a string table ADT and a symbol ID
+ * Output:
+ *      the name (null terminated), "" for an unknown ID
+ *****************/
+const char *symbolName (myStringTable st, int id) {
+    if (id < 0 || id >= st->nSymbols) return "";
+    return st->names + st->nameAt[id];
+}
+
+
+/*****************
+ * Function:
+ *      symbolCount
+ * Description:
+ *      Tell how many names are interned
+ * Input:
+ *      a string table ADT
+ * Output:
+ *      the number of symbols
+ *****************/
+int symbolCount (myStringTable st) {
+    return st->nSymbols;
+}
+
+
+/*****************
+ * Function:
+ *      clearStringTable
+ * Description:
+ *      free up memory used by a string table ADT, names included
+ * Input:
+ *      a string table ADT (may be NULL)
+ * Output:
+ *      released memory previously occupied by the string table ADT
+ *****************/
+void clearStringTable (myStringTable st) {
+    if (st == NULL) return;
+    free(st->slots);
+    free(st->names);
+    free(st->nameAt);
+    free(st);
+}
@@ -0,0 +1,109 @@
+/*
+ ============================================================================
+ Name        : stringTable.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : String table of identifiers. Every identifier is interned
+                by the scanner when it is found and receives a dense symbol ID
+                (0, 1, 2 ... in order of first appearance). Later phases
+                compare and index identifiers by ID instead of by name; the
+                name is only needed to print it (symbolName).
+                Names are kept, null terminated, in one growable block, and
+                found again through an open addressing hash table.
+                Each scanner owns its table (see scanner.h), so the IDs of a
+                source do not depend on other sources scanned before or at
+                the same time. A table is not locked: the parallel scanner
+                interns identifiers on one thread only.
+
+ ============================================================================
+ */
+
+#ifndef _STRINGTABLE_H_
+#define _STRINGTABLE_H_
+
+//configuration : initial sizes, both grow when needed
+#define symbolSlots (1024)              // hash slots, a power of 2, kept at most half full
+#define symbolNames (16384)             // bytes of names
+
+#define noSymbol (-1)
+
+typedef struct StringTable *myStringTable;
+struct StringTable {
+    int    *slots;                  // hash slot -> symbol ID + 1, 0 when empty
+    int     nSlots;
+    char   *names;                  // names, one after the other, null terminated
+    long    namesLen;
+    long    namesCap;
+    long   *nameAt;                 // symbol ID -> offset of its name
+    int     nSymbols;
+    int     symbolsCap;
+};
+
+
+/*****************
+ * Function:
+ *      newStringTable
+ * Description:
+ *      Create an empty string table, memory is only taken by the first name
+ * Input:
+ *      none
+ * Output:
+ *      a string table ADT
+ *****************/
+myStringTable newStringTable ();
+
+
+/*****************
+ * Function:
+ *      internSymbol
+ * Description:
+ *      Find the ID of a name, adding the name to the table the first time
+ * Input:
+ *      a string table ADT, the name (not necessarily null terminated) and its length
+ * Output:
+ *      the symbol ID of the name
+ *****************/
+int internSymbol (myStringTable st, const char *text, int len);
+
+
+/*****************
+ * Function:
+ *      symbolName
+ * Description:
+ *      Give the name of a symbol ID
+ * Input:
+ *      a string table ADT and a symbol ID
+ * Output:
+ *      the name (null terminated), "" for an unknown ID
+ *****************/
+const char *symbolName (myStringTable st, int id);
+
+
+/*****************
+ * Function:
+ *      symbolCount
+ * Description:
+ *      Tell how many names are interned, IDs go from 0 to symbolCount(st)-1
+ * Input:
+ *      a string table ADT
+ * Output:
+ *      the number of symbols
+ *****************/
+int symbolCount (myStringTable st);
+
+
+/*****************
+ * Function:
+ *      clearStringTable
+ * Description:
+ *      free up memory used by a string table ADT, names included
+ * Input:
+ *      a string table ADT (may be NULL)
+ * Output:
+ *      released memory previously occupied by the string table ADT
+ *****************/
+void clearStringTable (myStringTable st);
+
+#endif
@@ -1,31 +1,81 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+/simdScan.c \
 /scopeCheck.c \
+/scopeTable.c \
+/exprDag.c \
+/storage.c \
+/writer.c \
+/visitor.c \
 /traversals.c \
 /buildTree.c \
 /token.c \
+/tokenStream.c \
+/stringTable.c \
+/arena.c \
+/flatTree.c \
+/compiler.c \
+/textBuffer.c \
 /scanner.c \
 /parser.c \
+/llParser.c \
+/parallelParser.c \
 /main.c 
 
 OBJS += \
+./simdScan.o \
 ./scopeCheck.o \
+./scopeTable.o \
+./exprDag.o \
+./storage.o \
+./writer.o \
+./visitor.o \
 ./traversals.o \
 ./buildTree.o \
 ./token.o \
+./tokenStream.o \
+./stringTable.o \
+./arena.o \
+./flatTree.o \
+./compiler.o \
+./textBuffer.o \
 ./scanner.o \
 ./parser.o \
+./llParser.o \
+./parallelParser.o \
 ./main.o 
 
 C_DEPS += \
+./simdScan.d \
 ./scopeCheck.d \
+./scopeTable.d \
+./exprDag.d \
+./storage.d \
+./writer.d \
+./visitor.d \
 ./traversals.d \
 ./buildTree.d \
 ./token.d \
+./tokenStream.d \
+./stringTable.d \
+./arena.d \
+./flatTree.d \
+./compiler.d \
+./textBuffer.d \
 ./scanner.d \
 ./parser.d \
+./llParser.d \
+./parallelParser.d \
 ./main.d 
 
+# Sources generated at build time
+GEN_PROG = ./genDriver
+GEN_PARSER = ./genParser
+GEN_SRCS += \
+./driverTable.h \
+./driverDirect.h \
+./parseTable.h 
+
 
 # Each subdirectory must supply rules for building sources it contributes
 %.o: ./%.c
@@ -33,4 +83,25 @@ C_DEPS += \
 	@echo 'Finished $<'
 	@echo '--------------------'
 
+# The scanner driver table is generated once, at build time (see genDriver.c)
+./driverTable.h: ./genDriver.c ./token.h ./scanner.h
+	gcc -O2 -Wall -o $(GEN_PROG) ./genDriver.c
+	$(GEN_PROG) > $@
+	@echo 'Finished $@'
+	@echo '--------------------'
+
+./driverDirect.h: ./driverTable.h
+	$(GEN_PROG) direct > $@
+	@echo 'Finished $@'
+	@echo '--------------------'
+
+./scanner.o ./token.o: ./driverTable.h ./driverDirect.h
+
+# The LL(1) parse table is generated once, at build time (see genParser.c)
+./parseTable.h: ./genParser.c ./token.h
+	gcc -O2 -Wall -o $(GEN_PARSER) ./genParser.c
+	$(GEN_PARSER) > $@
+	@echo 'Finished $@'
+	@echo '--------------------'
 
+./llParser.o: ./parseTable.h
@@ -0,0 +1,192 @@
+/*
+ ============================================================================
+ Name        : textBuffer.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the text buffer declared in textBuffer.h
+ Functions	 : myTextBuffer newTextBuffer ()
+                myTextBuffer useTextBuffer (char *memory, long size)
+                void appendText (myTextBuffer b, const char *text, long len)
+                void printText (myTextBuffer b, const char *format, ...)
+                void printTextList (myTextBuffer b, const char *format, va_list args)
+                void emptyText (myTextBuffer b)
+                int textTruncated (myTextBuffer b)
+                void clearTextBuffer (myTextBuffer b)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include "./textBuffer.h"
+
+
+/*****************
+ * Function:
+ *      newTextBuffer
+ * Description:
+ *      Create an empty text buffer owning its memory
+ * Input:
+ *      none
+ * Output:
+ *      a text buffer ADT
+ *****************/
+myTextBuffer newTextBuffer () {
+    myTextBuffer b = malloc(sizeof(struct TextBuffer));
+    b->cap = textRoom;
+    b->text = malloc(b->cap);
+    b->text[0] = '\0';
+    b->len = 0;
+    b->owned = 1;
+    return b;
+}
+
+
+/*****************
+ * Function:
+ *      useTextBuffer
+ * Description:
+ *      Create an empty text buffer writing into the caller's memory
+ * Input:
+ *      a block of memory and its size in bytes (at least 1)
+ * Output:
+ *      a text buffer ADT, NULL if there is no memory
+ *****************/
+myTextBuffer useTextBuffer (char *memory, long size) {
+    myTextBuffer b;
+    if (memory == NULL || size < 1) return NULL;
+    b = malloc(sizeof(struct TextBuffer));
+    b->text = memory;
+    b->text[0] = '\0';
+    b->cap = size;
+    b->len = 0;
+    b->owned = 0;
+    return b;
+}
+
+
+/*****************
+ * Function:
+ *      appendText
+ * Description:
+ *      Add text at the end of the buffer. An owned buffer doubles until
+ *      the text fits, the caller's memory keeps what fits
+ * Input:
+ *      a text buffer ADT, the text (not necessarily null terminated) and its length
+ * Output:
+ *      none
+ *****************/
+void appendText (myTextBuffer b, const char *text, long len) {
+    long room;
+    if (b->owned) {
+        while (b->len + len + 1 > b->cap) {
+            b->cap *= 2;
+            b->text = realloc(b->text, b->cap);
+        }
+    }
+    room = b->cap - 1 - b->len;                 // bytes left before the null
+    if (room > len) room = len;
+    if (room > 0) {
+        memcpy(b->text + b->len, text, room);
+        b->text[b->len + room] = '\0';
+    }
+    b->len += len;
+}
+
+
+/*****************
+ * Function:
+ *      printText
+ * Description:
+ *      Add formatted text at the end of the buffer, as fprintf would
+ * Input:
+ *      a text buffer ADT, a format and its arguments
+ * Output:
+ *      none
+ *****************/
+void printText (myTextBuffer b, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    printTextList(b, format, args);
+    va_end(args);
+}
+
+
+/*****************
+ * Function:
+ *      printTextList
+ * Description:
+ *      Same as printText, with the arguments in a va_list (as vfprintf)
+ * Input:
+ *      a text buffer ADT, a format and its arguments
+ * Output:
+ *      none
+ *****************/
+void printTextList (myTextBuffer b, const char *format, va_list args) {
+    char line[512], *text = line;
+    va_list again;
+    int n;
+
+    va_copy(again, args);
+    n = vsnprintf(line, sizeof(line), format, args);
+    if (n >= (int) sizeof(line)) {                  // a long message, format it again in a block of its own
+        text = malloc(n + 1);
+        vsnprintf(text, n + 1, format, again);
+    }
+    va_end(again);
+    if (n < 0) return;
+    appendText(b, text, n);
+    if (text != line) free(text);
+}
+
+
+/*****************
+ * Function:
+ *      emptyText
+ * Description:
+ *      Forget the text, the memory is kept
+ * Input:
+ *      a text buffer ADT
+ * Output:
+ *      an empty text
+ *****************/
+void emptyText (myTextBuffer b) {
+    b->len = 0;
+    b->text[0] = '\0';
+}
+
+
+/*****************
+ * Function:
+ *      textTruncated
+ * Description:
+ *      Tell if the text did not fit in the caller's memory
+ * Input:
+ *      a text buffer ADT
+ * Output:
+ *      1 if some text was cut, 0 otherwise
+ *****************/
+int textTruncated (myTextBuffer b) {
+    return b->len > b->cap - 1;
+}
+
+
+/*****************
+ * Function:
+ *      clearTextBuffer
+ * Description:
+ *      free up memory used by a text buffer ADT, the text only if it is owned
+ * Input:
+ *      a text buffer ADT (may be NULL)
+ * Output:
+ *      released memory previously occupied by the text buffer ADT
+ *****************/
+void clearTextBuffer (myTextBuffer b) {
+    if (b == NULL) return;
+    if (b->owned) free(b->text);
+    free(b);
+}
@@ -0,0 +1,140 @@
+/*
+ ============================================================================
+ Name        : textBuffer.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Text buffer. Text is appended at the end of one null
+                terminated block of memory, which is either owned by the
+                buffer (it grows when full) or given by the caller (it never
+                grows: the text is cut to fit, and len still counts every
+                byte written, so the caller knows the room it needs).
+                Used to hand the outputs and messages of a compilation to a
+                caller without going through files (see compiler.h).
+
+ ============================================================================
+ */
+
+#ifndef _TEXTBUFFER_H_
+#define _TEXTBUFFER_H_
+
+#include <stdarg.h>
+
+//configuration : initial room of an owned buffer, doubled when full
+#define textRoom (4096)
+
+typedef struct TextBuffer *myTextBuffer;
+struct TextBuffer {
+    char   *text;                   // the text, null terminated
+    long    len;                    // bytes written, may exceed cap - 1 for a caller's buffer
+    long    cap;                    // bytes of memory in text
+    int     owned;                  // 1 if text belongs to the buffer, 0 if it is the caller's
+};
+
+
+/*****************
+ * Function:
+ *      newTextBuffer
+ * Description:
+ *      Create an empty text buffer owning its memory
+ * Input:
+ *      none
+ * Output:
+ *      a text buffer ADT
+ *****************/
+myTextBuffer newTextBuffer ();
+
+
+/*****************
+ * Function:
+ *      useTextBuffer
+ * Description:
+ *      Create an empty text buffer writing into the caller's memory. The
+ *      memory is never freed nor grown by the buffer
+ * Input:
+ *      a block of memory and its size in bytes (at least 1)
+ * Output:
+ *      a text buffer ADT, NULL if there is no memory
+ *****************/
+myTextBuffer useTextBuffer (char *memory, long size);
+
+
+/*****************
+ * Function:
+ *      appendText
+ * Description:
+ *      Add text at the end of the buffer
+ * Input:
+ *      a text buffer ADT, the text (not necessarily null terminated) and its length
+ * Output:
+ *      none
+ *****************/
+void appendText (myTextBuffer b, const char *text, long len);
+
+
+/*****************
+ * Function:
+ *      printText
+ * Description:
+ *      Add formatted text at the end of the buffer, as fprintf would
+ * Input:
+ *      a text buffer ADT, a format and its arguments
+ * Output:
+ *      none
+ *****************/
+void printText (myTextBuffer b, const char *format, ...);
+
+
+/*****************
+ * Function:
+ *      printTextList
+ * Description:
+ *      Same as printText, with the arguments in a va_list (as vfprintf)
+ * Input:
+ *      a text buffer ADT, a format and its arguments
+ * Output:
+ *      none
+ *****************/
+void printTextList (myTextBuffer b, const char *format, va_list args);
+
+
+/*****************
+ * Function:
+ *      emptyText
+ * Description:
+ *      Forget the text, the memory is kept
+ * Input:
+ *      a text buffer ADT
+ * Output:
+ *      an empty text
+ *****************/
+void emptyText (myTextBuffer b);
+
+
+/*****************
+ * Function:
+ *      textTruncated
+ * Description:
+ *      Tell if the text did not fit in the caller's memory
+ * Input:
+ *      a text buffer ADT
+ * Output:
+ *      1 if some text was cut, 0 otherwise
+ *****************/
+int textTruncated (myTextBuffer b);
+
+
+/*****************
+ * Function:
+ *      clearTextBuffer
+ * Description:
+ *      free up memory used by a text buffer ADT, the text only if it is owned
+ * Input:
+ *      a text buffer ADT (may be NULL)
+ * Output:
+ *      released memory previously occupied by the text buffer ADT
+ *****************/
+void clearTextBuffer (myTextBuffer b);
+
+#endif
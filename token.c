@@ -8,9 +8,20 @@
  Summary	 : 
  Functions	 :  myToken initToken () 
                 void clearToken 
-                int findNextState (const int currentState,const char c, int stateTable[100][100])
-                myToken checkReservedWord(myToken t)
+                int nextChar (myScanner s)
+                void stepBack (int c, myScanner s)
+                void runAhead (myScanner s, int kind, char *buffer, int *charRead)
+                int findNextState (const int currentState,const char c)
+                void checkReservedWord(myLexeme lx, const char *text)
+                void checkOperator(myLexeme lx, const char *text)
+                void acceptToken (myLexeme lx, int code, int charRead, char c, myScanner s)
+                void printTokenError (myScanner s, int code)
+                void rejectToken (myLexeme lx, char *text, int code, myScanner s)
+                void finishToken (myLexeme lx, char *text, int eofFlag, myScanner s)
+                void getLexemeDirect(myScanner s, myLexeme lx, char *buffer) (generated, see driverDirect.h)
+                void getLexeme(myScanner s, myLexeme lx, char *text)
                 myToken getToken(myScanner s) 
+                int lexemeKind (myLexeme lx)
                 int hasTokenError (myToken t) 
                 void printToken (myToken t) 
  ============================================================================
@@ -21,11 +32,12 @@
 #include <string.h>
 
 #include "./token.h"
+#include "./simdScan.h"
+#include "./stringTable.h"
+#include "./driverTable.h"
 
 //configurations
 //int bufLen = 100;
-int line = 0;
-int lineFlag = 0;
 
 
 /*****************
@@ -44,6 +56,8 @@ myToken initToken () {
     // allocate memory for scanner
 	t = malloc(sizeof(struct Token));
 	t->tokenLine = 0;
+	t->tokenKind = noKeyword;
+	t->tokenVal[0] = '\0';
     
     return t;
 }
@@ -68,55 +82,99 @@ void clearToken (myToken t)
 }
 
 
+/*****************
+ * Function:
+ *      nextChar
+ * Description:
+ *      This function is internal to the ADT.
+ *      Read the next character of the source, straight from the scanner's
+ *      buffer. For a stream, the next block is read once the buffer is
+ *      consumed; the caller keeps its state, so tokens may span blocks.
+ * Input:
+ *      a scanner ADT
+ * Output:
+ *      the next character, or EOF when the source is exhausted
+ *****************/
+static inline int nextChar (myScanner s) {
+    if (s->srcPos >= s->srcLen && readBlock(s) == 0) return EOF;
+    return (unsigned char) s->src[s->srcPos++];
+}
+
+/*****************
+ * Function:
+ *      stepBack
+ * Description:
+ *      This function is internal to the ADT.
+ *      Give back the character that ended a token so the next call to
+ *      getToken starts with it. New lines and EOF reach this point already
+ *      turned into a white space, which the next token would skip anyway,
+ *      so the buffer cursor only moves back for any other character.
+ *      That character was just read from the current block, so it is
+ *      still there.
+ * Input:
+ *      the character to give back and a scanner ADT
+ * Output:
+ *      none
+ *****************/
+static inline void stepBack (int c, myScanner s) {
+    if (c != ' ') s->srcPos--;
+}
+
+
+/*****************
+ * Function:
+ *      runAhead
+ * Description:
+ *      This function is internal to the ADT.
+ *      Consume at once the run of characters that keeps the driver in its
+ *      current state (see driverRun in driverTable.h): white space in the
+ *      start state, letters and digits in identifiers and comments, digits
+ *      in integers. The run is measured with the vectorized helpers of
+ *      simdScan.h. A run stops at the end of the current block.
+ *      It has the same effect as stepping through the run one character at
+ *      a time: new lines are counted, other characters are appended to the
+ *      token buffer, which is never filled beyond bufLen.
+ * Input:
+ *      a scanner ADT, the kind of run, the token buffer and its length
+ * Output:
+ *      none
+ *****************/
+static inline void runAhead (myScanner s, int kind, char *buffer, int *charRead) {
+    const char *p = s->src + s->srcPos;
+    long n = s->srcLen - s->srcPos;
+    long k, lines;
+
+    if (kind == driverRunBlank) {
+        k = scanBlankRun(p, n, &lines);
+        s->lineFlag += lines;
+    } else {
+        if (n > bufLen - *charRead) n = bufLen - *charRead;
+        if (kind == driverRunAlnum) k = scanAlnumRun(p, n);
+        else k = scanDigitRun(p, n);
+        memcpy(buffer + *charRead, p, k);
+        *charRead += k;
+    }
+    s->srcPos += k;
+}
+
+
 /*****************
  * Function:
  *      findNextState
  * Description:
  *      This function is internal to the ADT. 
- *      The function will translate a character to its respective ascii value
+ *      The function will translate a character to its character class
  *      The initial state is 0 (when no character is read)
- *      Based on the translated value, the function will find the next state
- *      per driver table specified by the scanner
+ *      Based on the character class, the function will find the next state
+ *      per the driver table shared by all scanners (see driverTable.h)
  * Input:
- *      current driver state, a character and a reference to a scanner's driver table
+ *      current driver state and a character
  * Output:
- *      an integer value (of the next state)
+ *      an integer value (of the next state, or a token/error code)
  *****************/
-int findNextState (const int currentState,const char c, int stateTable[100][100]) {
-    int nextState = 0;
-    int currentVal = (int) c;
-    //map currentVal
-    if ((currentVal>=65 && currentVal<=90) || (currentVal>=97 && currentVal<=122)){
-        currentVal = 0; //map to col 0 in mapped automaton table
-    }
-    else if (currentVal>=48 && currentVal <=57){
-        currentVal = 1;
-    }
-    else if (currentVal == 32) currentVal = 2;
-    else if (currentVal == 61) currentVal = 3;
-    else if (currentVal == 60) currentVal = 4;
-    else if (currentVal == 62) currentVal = 5;
-    else if (currentVal == 33) currentVal = 6;
-    else if (currentVal == 58) currentVal = 7;
-    else if (currentVal == 43) currentVal = 8;
-    else if (currentVal == 45) currentVal = 9;
-    else if (currentVal == 42) currentVal = 10;
-    else if (currentVal == 47) currentVal = 11;
-    else if (currentVal == 38) currentVal = 12;
-    else if (currentVal == 37) currentVal = 13;
-    else if (currentVal == 46) currentVal = 14;
-    else if (currentVal == 40) currentVal = 15;
-    else if (currentVal == 41) currentVal = 16;
-    else if (currentVal == 44) currentVal = 17;
-    else if (currentVal == 123) currentVal = 18;
-    else if (currentVal == 125) currentVal = 19;
-    else if (currentVal == 59) currentVal = 20;
-    else if (currentVal == 91) currentVal = 21;
-    else if (currentVal == 93) currentVal = 22;
-    else if (currentVal == 64) currentVal = 23;
-    else currentVal = 24;
-    
-    nextState = stateTable[currentState][currentVal];
+static inline int findNextState (const int currentState,const char c) {
+    int nextState = driverTable[currentState][charClass[(unsigned char) c]];
+    if (nextState >= driverFinal) nextState = driverCode(nextState);
     //printf ("Next state is : %d \n", nextState);
     return nextState;
     
@@ -126,74 +184,219 @@ int findNextState (const int currentState,const char c, int stateTable[100][100]
  * Function:
  *      checkReservedWord
  * Description: 
- *      check if a token is indeed a keyword token
+ *      check if a token is indeed a keyword token.
+ *      Only identifiers can be keywords, and only when they are exactly one
+ *      of the reserved words: the word is looked up in the perfect hash
+ *      generated in driverTable.h (one hash, one compare). The lexeme also
+ *      receives the kind of that keyword.
  * Input:
- *      a token ADT
+ *      a lexeme and its text
  * Output:
- *      a token ADT
+ *      none
  *****************/
-myToken checkReservedWord(myToken t) {
-    if ((strstr(t->tokenVal,"Begin")!=NULL ||
-        strstr(t->tokenVal,"End")!=NULL ||
-        strstr(t->tokenVal,"Start")!=NULL ||
-        strstr(t->tokenVal,"Stop")!=NULL ||
-        strstr(t->tokenVal,"Iff")!=NULL ||
-        strstr(t->tokenVal,"Loop")!=NULL ||
-        strstr(t->tokenVal,"Void")!=NULL ||
-        strstr(t->tokenVal,"Var")!=NULL ||
-        strstr(t->tokenVal,"Int")!=NULL ||
-        strstr(t->tokenVal,"Call")!=NULL ||
-        strstr(t->tokenVal,"Return")!=NULL ||
-        strstr(t->tokenVal,"Scan")!=NULL ||
-        strstr(t->tokenVal,"Print")!=NULL ||
-        strstr(t->tokenVal,"Program")!=NULL) &&
-        strstr(t->tokenVal,"@")==NULL               // rule out the chance of keywords appear in a comment
-    )
-
-        t->tokenType = keywordCode;
-    
-    return t;
+static void checkReservedWord(myLexeme lx, const char *text) {
+    int slot;
+    if (lx->type != idCode || lx->len == 0 || lx->len > keywordMaxLen) return;
+    slot = keywordHash(text, lx->len);
+    if (keywordKind[slot] != noKeyword && strcmp(text, keywordText[slot]) == 0) {
+        lx->type = keywordCode;
+        lx->value = keywordKind[slot];
+    }
 }
 
 
 /*****************
  * Function:
- *      getToken
+ *      checkOperator
+ * Description:
+ *      This function is internal to the ADT.
+ *      Give relational, other and delimiter tokens the kind of the symbol
+ *      they are. The automaton only accepts the symbols of README.md, so the
+ *      first character and the length are enough.
+ * Input:
+ *      a lexeme and its text
+ * Output:
+ *      none
+ *****************/
+static void checkOperator(myLexeme lx, const char *text) {
+    if (lx->type != relCode && lx->type != otherCode && lx->type != delimCode) return;
+    switch (text[0]) {
+        case '=': lx->value = (lx->len == 1) ? equalOperator : (text[1] == '=') ? assignOperator : notEqualOperator; break;
+        case '<': lx->value = (lx->len == 1) ? lessOperator : lessEqualOperator; break;
+        case '>': lx->value = (lx->len == 1) ? greaterOperator : greaterEqualOperator; break;
+        case ':': lx->value = colonOperator; break;
+        case '+': lx->value = plusOperator; break;
+        case '-': lx->value = minusOperator; break;
+        case '*': lx->value = timesOperator; break;
+        case '/': lx->value = divideOperator; break;
+        case '&': lx->value = ampersandOperator; break;
+        case '%': lx->value = percentOperator; break;
+        case '.': lx->value = dotDelimiter; break;
+        case '(': lx->value = openParenDelimiter; break;
+        case ')': lx->value = closeParenDelimiter; break;
+        case ',': lx->value = commaDelimiter; break;
+        case '{': lx->value = openBraceDelimiter; break;
+        case '}': lx->value = closeBraceDelimiter; break;
+        case ';': lx->value = semicolonDelimiter; break;
+        case '[': lx->value = openBracketDelimiter; break;
+        case ']': lx->value = closeBracketDelimiter; break;
+        default: break;
+    }
+}
+
+
+/*****************
+ * Function:
+ *      acceptToken
+ * Description:
+ *      This function is internal to the ADT.
+ *      Complete a token once the driver reaches a token code: the pending
+ *      new lines are added to the line count, the lexeme is located in the
+ *      source (it ends right before the character that ended the token)
+ *      and that character is given back. A new line ending the token is
+ *      already counted, the token itself is on the line before.
+ * Input:
+ *      the lexeme, the token code, the number of buffered characters,
+ *      the character that ended the token and a scanner ADT
+ * Output:
+ *      none
+ *****************/
+static inline void acceptToken (myLexeme lx, int code, int charRead, char c, myScanner s) {
+    s->line = s->line + s->lineFlag;
+    s->lineFlag = 0;
+    lx->type = code;
+    lx->len = charRead;
+    lx->line = s->line;
+    if (c == ' ' && s->srcPos > 0 && s->src[s->srcPos - 1] == '\n') lx->line--;
+    lx->offset = s->srcBase + s->srcPos - 1 - charRead;
+    stepBack(c, s);                                       // step back one character
+}
+
+/*****************
+ * Function:
+ *      printTokenError
+ * Description:
+ *      This function is globally available
+ *      Print the scanner message of an error code
+ * Input:
+ *      the scanner of the token and a token or error code
+ * Output:
+ *      the message on stderr (or in the scanner's messages), nothing for token codes
+ *****************/
+void printTokenError (myScanner s, int code) {
+    if (s->messages != NULL) {
+        if (code==980) printText (s->messages,"ERROR : Invalid token!! \n");
+        if (code==981) printText (s->messages,"ERROR : Character is not in the allowed alphabet. \n");
+        if (code==982) printText (s->messages,"[ERROR] Token name exceeds %d characters!! \n", bufLen);
+        return;
+    }
+    if (code==980) fprintf (stderr,"ERROR : Invalid token!! \n");
+    if (code==981) fprintf (stderr,"ERROR : Character is not in the allowed alphabet. \n");
+    if (code==982) fprintf (stderr,"[ERROR] Token name exceeds %d characters!! \n", bufLen);
+}
+
+/*****************
+ * Function:
+ *      rejectToken
+ * Description:
+ *      This function is internal to the ADT.
+ *      Turn a token into an error token once the driver reaches an error code.
+ *      The message is printed unless the scanner is quiet.
+ * Input:
+ *      the lexeme, its text buffer, the error code and a scanner ADT
+ * Output:
+ *      none
+ *****************/
+static void rejectToken (myLexeme lx, char *text, int code, myScanner s) {
+    if (s->quiet == 0) printTokenError(s, code);
+    lx->type = code;
+    lx->line = s->line;
+    lx->offset = -1;
+    strcpy(text, "[Error]");
+    lx->len = strlen(text);
+}
+
+/*****************
+ * Function:
+ *      finishToken
+ * Description:
+ *      This function is internal to the ADT.
+ *      Last step shared by both scanner engines: keywords are recognized,
+ *      operators and delimiters get their kind, integers get their value, identifiers get their symbol ID (unless the
+ *      scanner leaves interning to its caller), and the token is replaced by
+ *      the EOF token when the end of the source was reached.
+ * Input:
+ *      the lexeme, its text, the EOF flag and a scanner ADT
+ * Output:
+ *      none
+ *****************/
+static void finishToken (myLexeme lx, char *text, int eofFlag, myScanner s) {
+    checkReservedWord(lx, text);
+    checkOperator(lx, text);
+    if (lx->type == intCode) lx->value = strtol(text, NULL, 10);
+    if (lx->type == idCode && s->intern == 1) lx->value = internSymbol(s->symbols, text, lx->len);
+
+    if (eofFlag == 1) {
+        strcpy(text, "EOF");
+        lx->type = eofCode; //998
+        lx->len = strlen(text);
+        lx->offset = -1;
+        lx->value = 0;
+        lx->line = s->line + s->lineFlag;                  // the last line of the source
+    }
+}
+
+//direct-coded engine, generated from the same automaton (see genDriver.c)
+#include "./driverDirect.h"
+
+
+/*****************
+ * Function:
+ *      getLexeme
  * Description: 
  *      This function is globally available
  *      The function will process each character received from the scanner
  *      and try to construct a complete token by using the scanner driver.
  *      The process stops when a specified token code is reached or an error
  *      code is encountered.
+ *      Scanners built for the direct-coded engine are handed over to
+ *      getLexemeDirect, the others interpret the driver table.
  * Input:
- *      a scanner ADT
+ *      a scanner ADT, the lexeme to fill and a text buffer of bufLen+1 bytes
  * Output:
- *      a token ADT
+ *      the lexeme filled and its text in the buffer
  *****************/
-myToken getToken(myScanner s) {
+void getLexeme(myScanner s, myLexeme lx, char *buffer) {
     
     int currentState = 0;
     int charRead = 0;
-    char c;
-    char buffer[bufLen];
+    int c;                                                      // a byte of the source, or EOF
     int flag = 0;
     int eofFlag = 0;
     
-    // initialize token
-    myToken t;
-    t = initToken ();
+    // initialize lexeme
+    lx->type = 0;
+    lx->len = 0;
+    lx->line = 0;
+    lx->offset = -1;
+    lx->value = 0;
+    memset(buffer, 0, bufLen + 1);
+    if (s->engine == directEngine) {
+        getLexemeDirect(s, lx, buffer);
+        return;
+    }
+
     // get first character from the scanner
-    c = fgetc(s->fp);
-    memset(buffer, 0, sizeof(buffer));
+    c = nextChar(s);
     // now process the received character
     while (flag==0) {
         
-        if (charRead + 1 > bufLen) {
-            flag = 1;
-            fprintf (stderr,"[ERROR] Token name exceeds %d characters!! \n", bufLen);
-            }                     //concat all characters beyond buffer
+        if (charRead + 1 > bufLen) {                            // no room left in the buffer
+            rejectToken(lx, buffer, tooLong_errorCode, s);
+            break;
+        }
         if (c == '\n') {                                        //in case of a new line 
-            lineFlag++;
+            s->lineFlag++;
             c = ' ';                                            //treat it as a white space
         }
         
@@ -204,49 +407,83 @@ myToken getToken(myScanner s) {
             eofFlag = 1;
         }
         
-		currentState = findNextState (currentState, c, s->table);
+		currentState = findNextState (currentState, c);
 		
 		if (currentState>=991 && currentState <=999) {            // if a correct token is found
 		    flag = 1;
-		    line = line + lineFlag;
-            lineFlag = 0;
-		    t->tokenType = currentState;
-		    strcpy(t->tokenVal, buffer);
-		    t->tokenLine = line;
-		    memset(buffer, 0, sizeof(buffer));                // clearing the buffer
-            ungetc(c, s->fp);                                     // step back one character
+		    acceptToken(lx, currentState, charRead, c, s);
 		}
 		else if (currentState>=980 && currentState <=989) {       // if an error is found
-            if (currentState==980) fprintf (stderr,"ERROR : Invalid token!! \n");
-            if (currentState==981) fprintf (stderr,"ERROR : Character is not in the allowed alphabet. \n");
             flag = 1;
-		    t->tokenType = currentState;
-		    strcpy(t->tokenVal, "[Error]");
-		    t->tokenLine = line;
-		    memset(buffer, 0, sizeof(buffer));                // clearing the buffer
+		    rejectToken(lx, buffer, currentState, s);
         }
         else {
-            int temp;
-            temp = isspace((int) c);
-            if (temp == 0) buffer[charRead++] = c;							      // append c to buffer, skip white space
-            c = fgetc(s->fp);
+            if (c != ' ') buffer[charRead++] = c;                 // append c to buffer, skip white space
+            if (driverRun[currentState] != driverRunNone && flag == 0) {
+                runAhead(s, driverRun[currentState], buffer, &charRead);
+            }
+            c = nextChar(s);
             
         }
 
 	}
     
-    t = checkReservedWord(t);
+    finishToken(lx, buffer, eofFlag, s);
+}
 
-    if (eofFlag == 1) {
-        strcpy(t->tokenVal, "EOF");
-        t->tokenType = eofCode; //998
-    }
 
-    memset(buffer, 0, sizeof(buffer));
+/*****************
+ * Function:
+ *      getToken
+ * Description: 
+ *      This function is globally available
+ *      Build the next token ADT of the scanner (see getLexeme)
+ * Input:
+ *      a scanner ADT
+ * Output:
+ *      a token ADT
+ *****************/
+myToken getToken(myScanner s) {
+    struct Lexeme lx;
+    char buffer[bufLen + 1];
+    myToken t;
+
+    getLexeme(s, &lx, buffer);
+    t = initToken ();
+    t->tokenType = lx.type;
+    t->tokenLine = lx.line;
+    t->tokenKind = lexemeKind(&lx);
+    strcpy(t->tokenVal, buffer);
     return t;
 }
 
 
+/*****************
+ * Function:
+ *      lexemeKind
+ * Description:
+ *      This function is globally available
+ *      Give the kind of a token. Keywords, operators and delimiters hold
+ *      their kind in their value, the other tokens get the kind of their code.
+ * Input:
+ *      a lexeme
+ * Output:
+ *      a token kind, noKeyword for errors and comments
+ *****************/
+int lexemeKind (myLexeme lx) {
+    switch (lx->type) {
+        case keywordCode:
+        case relCode:
+        case otherCode:
+        case delimCode: return lx->value;
+        case idCode: return identifierKind;
+        case intCode: return integerKind;
+        case eofCode: return eofKind;
+        default: return noKeyword;
+    }
+}
+
+
 /*****************
  * Function:
  *      hasTokenError
@@ -34,6 +34,7 @@
 //configuration : error codes
 #define invalidToken_errorCode (980)
 #define invalidCharacter_errorCode (981)
+#define tooLong_errorCode (982)
 
 //configuration : token codes
 #define idCode (991)
@@ -45,12 +46,71 @@
 #define keywordCode (997)
 #define eofCode (998)
 
+//configuration : token kinds, the parser switches on them (see lexemeKind)
+//keyword kinds, one per reserved word
+#define noKeyword (0)
+#define beginKeyword (1)
+#define endKeyword (2)
+#define startKeyword (3)
+#define stopKeyword (4)
+#define iffKeyword (5)
+#define loopKeyword (6)
+#define voidKeyword (7)
+#define varKeyword (8)
+#define intKeyword (9)
+#define callKeyword (10)
+#define returnKeyword (11)
+#define scanKeyword (12)
+#define printKeyword (13)
+#define programKeyword (14)
+
+//operator and delimiter kinds, one per symbol
+#define equalOperator (15)              // =
+#define lessOperator (16)               // <
+#define greaterOperator (17)            // >
+#define notEqualOperator (18)           // =!=
+#define greaterEqualOperator (19)       // >=>
+#define lessEqualOperator (20)          // <=<
+#define assignOperator (21)             // ==
+#define colonOperator (22)              // :
+#define plusOperator (23)               // +
+#define minusOperator (24)              // -
+#define timesOperator (25)              // *
+#define divideOperator (26)             // /
+#define ampersandOperator (27)          // &
+#define percentOperator (28)            // %
+#define dotDelimiter (29)               // .
+#define openParenDelimiter (30)         // (
+#define closeParenDelimiter (31)        // )
+#define commaDelimiter (32)             // ,
+#define openBraceDelimiter (33)         // {
+#define closeBraceDelimiter (34)        // }
+#define semicolonDelimiter (35)         // ;
+#define openBracketDelimiter (36)       // [
+#define closeBracketDelimiter (37)      // ]
+
+//kinds of the remaining tokens (errors and comments are noKeyword)
+#define identifierKind (38)
+#define integerKind (39)
+#define eofKind (40)
+
 //declare Token structure
 typedef struct Token *myToken;
 struct Token {
     int tokenType;
     char tokenVal[bufLen];
     int  tokenLine;
+    int  tokenKind;         // kind of the token (see lexemeKind)
+};
+
+//declare Lexeme structure : a compact token, the text stays in the source
+typedef struct Lexeme *myLexeme;
+struct Lexeme {
+    unsigned short type;    // token code, or error code
+    unsigned short len;     // length of the lexeme
+    int  line;              // line where the token is found
+    long offset;            // start of the lexeme in the source, -1 if the text is not there
+    long value;             // kind of keywords, operators and delimiters, value of integers, symbol ID of identifiers, 0 otherwise
 };
 
 /*****************
@@ -86,6 +146,25 @@ void printToken (myToken t);
 myToken getToken(myScanner s);
 
 
+/*****************
+ * Function:
+ *      getLexeme
+ * Description: 
+ *      This function is globally available
+ *      Same as getToken, without building a token ADT: the token is
+ *      described by a compact lexeme. When the scanner holds the source in
+ *      memory, the offset of the lexeme points into it; otherwise the offset
+ *      is -1 and the text is only found in the given text buffer.
+ *      Error tokens and the EOF token have an offset of -1, their text is
+ *      "[Error]" and "EOF".
+ * Input:
+ *      a scanner ADT, the lexeme to fill and a text buffer of bufLen+1 bytes
+ * Output:
+ *      the lexeme filled and its text in the buffer (null terminated)
+ *****************/
+void getLexeme(myScanner s, myLexeme lx, char *text);
+
+
 /*****************
  * Function:
  *      hasTokenError
@@ -103,6 +182,37 @@ myToken getToken(myScanner s);
  *****************/
 int hasTokenError (myToken t); 
 
+
+/*****************
+ * Function:
+ *      printTokenError
+ * Description:
+ *      This function is globally available
+ *      Print the scanner message of an error code (for quiet scanners,
+ *      whose errors are reported by the caller)
+ * Input:
+ *      the scanner of the token and a token or error code
+ * Output:
+ *      the message on stderr (or in the scanner's messages, see scanner.h),
+ *      nothing for token codes
+ *****************/
+void printTokenError (myScanner s, int code);
+
+
+/*****************
+ * Function:
+ *      lexemeKind
+ * Description:
+ *      This function is globally available
+ *      Give the kind of a token: the reserved word, operator or delimiter
+ *      it is, or identifierKind, integerKind, eofKind
+ * Input:
+ *      a lexeme
+ * Output:
+ *      a token kind (see above), noKeyword for errors and comments
+ *****************/
+int lexemeKind (myLexeme lx);
+
 void clearToken (myToken t);
 
 #endif
\ No newline at end of file
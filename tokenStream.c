@@ -0,0 +1,410 @@
+/*
+ ============================================================================
+ Name        : tokenStream.c
+ Author      : NGUYEN, TAM N
+ Created on  : 13NOV16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the token stream ADT declared in tokenStream.h
+ Functions	 : myTokenStream openTokenStream(myScanner s)
+                long poolText (myTokenStream ts, const char *text, int len)
+                int processors ()
+                void *scanChunk (void *arg)
+                void scanInParallel (myTokenStream ts)
+                myLexeme streamToken(myTokenStream ts, long i)
+                long streamAll(myTokenStream ts)
+                const char *lexemeText(myTokenStream ts, myLexeme lx)
+                const char *lexemeFind(myTokenStream ts, myLexeme lx, const char *word)
+                char *lexemeCopy(myTokenStream ts, myLexeme lx, char *out, int size)
+                int lexemeError(myTokenStream ts, myLexeme lx)
+                void clearTokenStream(myTokenStream ts)
+ ============================================================================
+ */
+
+#define _GNU_SOURCE                     // sched_getaffinity
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "./tokenStream.h"
+#include "./stringTable.h"
+
+//one part of the source, scanned by its own thread
+struct Chunk {
+    struct Scanner scanner;         // scans this part only, quietly
+    long start;                     // where the part starts in the source
+    struct Lexeme *tokens;
+    long count;
+    long capacity;
+};
+
+
+/*****************
+ * Function:
+ *      openTokenStream
+ * Description:
+ *      Create a token stream reading tokens from a scanner
+ * Input:
+ *      a scanner ADT
+ * Output:
+ *      a token stream ADT, NULL if there is no scanner
+ *****************/
+myTokenStream openTokenStream(myScanner s) {
+    myTokenStream ts;
+    if (s == NULL) return NULL;
+    ts = malloc(sizeof(struct TokenStream));
+    ts->scanner = s;
+    ts->first = 0;
+    ts->count = 0;
+    ts->capacity = streamTokens;
+    ts->tokens = malloc(ts->capacity * sizeof(struct Lexeme));
+    ts->pool = NULL;
+    ts->poolLen = 0;
+    ts->poolCap = 0;
+    ts->ahead = 0;
+    ts->reported = 0;
+    return ts;
+}
+
+
+/*****************
+ * Function:
+ *      poolText
+ * Description:
+ *      This function is internal to the ADT.
+ *      Keep the text of a lexeme when the scanner reads a stream
+ * Input:
+ *      a token stream ADT, the text and its length
+ * Output:
+ *      the offset of the text in the pool
+ *****************/
+static long poolText (myTokenStream ts, const char *text, int len) {
+    long offset = ts->poolLen;
+    if (ts->poolLen + len > ts->poolCap) {
+        while (ts->poolLen + len > ts->poolCap) ts->poolCap = ts->poolCap ? ts->poolCap * 2 : streamPool;
+        ts->pool = realloc(ts->pool, ts->poolCap);
+    }
+    memcpy(ts->pool + ts->poolLen, text, len);
+    ts->poolLen += len;
+    return offset;
+}
+
+
+/*****************
+ * Function:
+ *      processors
+ * Description:
+ *      This function is internal to the ADT.
+ *      Count the processors this program may run on
+ * Input:
+ *      none
+ * Output:
+ *      a number of processors, at least 1
+ *****************/
+static int processors () {
+    cpu_set_t set;
+    long n;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) return CPU_COUNT(&set);
+    n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? n : 1;
+}
+
+
+/*****************
+ * Function:
+ *      scanChunk
+ * Description:
+ *      This function is internal to the ADT.
+ *      Thread body: scan every token of a chunk. A chunk ends with a new
+ *      line, so its EOF token is not a token of the source and is dropped.
+ * Input:
+ *      a chunk
+ * Output:
+ *      the tokens and the line counters of the chunk
+ *****************/
+static void *scanChunk (void *arg) {
+    struct Chunk *ck = arg;
+    char text[bufLen + 1];
+    do {
+        if (ck->count == ck->capacity) {
+            ck->capacity = ck->capacity * 2;
+            ck->tokens = realloc(ck->tokens, ck->capacity * sizeof(struct Lexeme));
+        }
+        getLexeme(&ck->scanner, &ck->tokens[ck->count], text);
+    } while (ck->tokens[ck->count++].type != eofCode);
+    ck->count--;
+    return NULL;
+}
+
+
+/*****************
+ * Function:
+ *      scanInParallel
+ * Description:
+ *      This function is internal to the ADT.
+ *      Scan the source up to its last new line with several threads, one
+ *      chunk each, and stitch the tokens together. The rest of the source
+ *      (the last line) is left to the scanner, so the end of the source is
+ *      handled as usual.
+ *      The scanner keeps two line counters: committed lines, and new lines
+ *      seen but not yet counted (they are counted when a token is accepted,
+ *      error tokens only get the committed lines). A chunk starts with both
+ *      at 0, so its lines are fixed up with the counters the scanner would
+ *      have at the start of the chunk.
+ *      The string table is not shared with the threads: identifiers are
+ *      interned while stitching, in source order, so they get the same
+ *      symbol IDs as with one thread.
+ *      Nothing is done when the source is too small for two chunks or
+ *      when there is only one processor.
+ * Input:
+ *      a token stream ADT with no token yet
+ * Output:
+ *      the tokens of the source up to its last new line
+ *****************/
+static void scanInParallel (myTokenStream ts) {
+    myScanner s = ts->scanner;
+    struct Chunk chunks[maxThreads];
+    pthread_t threads[maxThreads];
+    int started[maxThreads];
+    long tail = s->srcLen;
+    long start = 0, total = 0, i;
+    int n = s->threads;
+    int k, seen;
+    int committed = s->line, pending = s->lineFlag;     // counters at the start of the next chunk
+
+    while (tail > 0 && s->src[tail - 1] != '\n') tail--;
+    if (n > processors()) n = processors();
+    if (n > tail / chunkMin) n = tail / chunkMin;
+    if (n < 2) return;
+
+    for (k = 0; k<n; k++) {
+        long end = (k == n - 1) ? tail : tail / n * (k + 1);
+        if (end < start) end = start;
+        while (end < tail && s->src[end - 1] != '\n') end++;   // cut right after a new line
+        chunks[k].scanner = *s;
+        chunks[k].scanner.src = s->src + start;
+        chunks[k].scanner.srcLen = end - start;
+        chunks[k].scanner.srcPos = 0;
+        chunks[k].scanner.srcMapped = 0;
+        chunks[k].scanner.quiet = 1;
+        chunks[k].scanner.intern = 0;
+        chunks[k].scanner.line = 0;
+        chunks[k].scanner.lineFlag = 0;
+        chunks[k].start = start;
+        chunks[k].count = 0;
+        chunks[k].capacity = streamTokens;
+        chunks[k].tokens = malloc(chunks[k].capacity * sizeof(struct Lexeme));
+        started[k] = (pthread_create(&threads[k], NULL, scanChunk, &chunks[k]) == 0);
+        if (!started[k]) scanChunk(&chunks[k]);
+        start = end;
+    }
+    for (k = 0; k<n; k++) {
+        if (started[k]) pthread_join(threads[k], NULL);
+        total += chunks[k].count;
+    }
+
+    if (total > ts->capacity) {
+        ts->capacity = total + streamTokens;
+        ts->tokens = realloc(ts->tokens, ts->capacity * sizeof(struct Lexeme));
+    }
+    for (k = 0; k<n; k++) {
+        seen = 0;                                   // no token accepted yet in this chunk
+        for (i = 0; i<chunks[k].count; i++) {
+            myLexeme lx = &ts->tokens[ts->count++];
+            *lx = chunks[k].tokens[i];
+            if (lx->offset >= 0) lx->offset += chunks[k].start;
+            if (lx->type == idCode) lx->value = internSymbol(s->symbols, s->src + lx->offset, lx->len);
+            if (lx->type >= idCode && lx->type < eofCode) seen = 1;
+            lx->line += committed + (seen ? pending : 0);
+        }
+        if (seen) {
+            committed += pending + chunks[k].scanner.line;
+            pending = chunks[k].scanner.lineFlag;
+        } else pending += chunks[k].scanner.lineFlag;
+        free(chunks[k].tokens);
+    }
+
+    //the scanner goes on with the last line as if it had scanned everything before
+    s->srcPos = tail;
+    s->line = committed;
+    s->lineFlag = pending;
+    ts->ahead = ts->count;
+}
+
+
+/*****************
+ * Function:
+ *      streamToken
+ * Description:
+ *      Give the token at a position of the stream, scanning tokens until
+ *      that position is reached. Past the end of the source, the scanner
+ *      keeps giving EOF tokens.
+ *      On the first call, the source may be scanned in parallel.
+ * Input:
+ *      a token stream ADT and a position (0 for the first token)
+ * Output:
+ *      a lexeme
+ *****************/
+myLexeme streamToken(myTokenStream ts, long i) {
+    char text[bufLen + 1];
+    if (ts->count == 0 && ts->scanner->threads > 1 && ts->scanner->fd < 0) scanInParallel(ts);
+    while (ts->reported < ts->ahead && ts->reported <= i) {
+        printTokenError(ts->scanner, ts->tokens[ts->reported++].type);     // as if it was scanned now
+    }
+    if (ts->scanner->fd >= 0 && i >= ts->first + ts->count) {
+        ts->first = ts->first + ts->count;                  // forget the tokens given out, and their texts
+        ts->count = 0;
+        ts->poolLen = 0;
+    }
+    while (ts->first + ts->count <= i) {
+        myLexeme lx;
+        if (ts->count == ts->capacity) {
+            ts->capacity = ts->capacity * 2;
+            ts->tokens = realloc(ts->tokens, ts->capacity * sizeof(struct Lexeme));
+        }
+        lx = &ts->tokens[ts->count++];
+        getLexeme(ts->scanner, lx, text);
+        if (ts->scanner->fd >= 0) lx->offset = poolText(ts, text, lx->len);
+    }
+    return &ts->tokens[i - ts->first];
+}
+
+
+/*****************
+ * Function:
+ *      streamAll
+ * Description:
+ *      Scan every token of the source at once, quietly: the scanner
+ *      messages are printed when the tokens are given out, as for the
+ *      tokens scanned in parallel. When no token is an error, nothing is
+ *      left to print and streamToken only reads the array, so several
+ *      threads may then share the stream.
+ * Input:
+ *      a token stream ADT with no token given out yet
+ * Output:
+ *      the number of tokens, the EOF one included; -1 if one of them is an
+ *      error token or if the scanner reads a stream
+ *****************/
+long streamAll(myTokenStream ts) {
+    myScanner s = ts->scanner;
+    char text[bufLen + 1];
+    int quiet = s->quiet;
+    long i, errors = 0;
+
+    if (s->fd >= 0) return -1;
+    if (ts->count == 0 && s->threads > 1) scanInParallel(ts);
+    s->quiet = 1;
+    while (ts->count == 0 || ts->tokens[ts->count - 1].type != eofCode) {
+        if (ts->count == ts->capacity) {
+            ts->capacity = ts->capacity * 2;
+            ts->tokens = realloc(ts->tokens, ts->capacity * sizeof(struct Lexeme));
+        }
+        getLexeme(s, &ts->tokens[ts->count++], text);
+    }
+    s->quiet = quiet;
+    ts->ahead = ts->count;
+
+    for (i = 0; i<ts->count - 1; i++) {
+        if (lexemeError(ts, &ts->tokens[i]) != 0 && lexemeKind(&ts->tokens[i]) != eofKind) errors++;
+    }
+    if (errors > 0) return -1;
+    ts->reported = ts->ahead;                   // no message is left to print
+    return ts->count;
+}
+
+
+/*****************
+ * Function:
+ *      lexemeText
+ * Description:
+ *      Locate the text of a lexeme (not null terminated, see lx->len)
+ * Input:
+ *      a token stream ADT and one of its lexemes
+ * Output:
+ *      a pointer to the first character of the lexeme
+ *****************/
+const char *lexemeText(myTokenStream ts, myLexeme lx) {
+    if (lx->offset < 0) return (lx->type == eofCode) ? "EOF" : "[Error]";
+    if (ts->scanner->fd >= 0) return ts->pool + lx->offset;
+    return ts->scanner->src + lx->offset;
+}
+
+
+/*****************
+ * Function:
+ *      lexemeFind
+ * Description:
+ *      Same as strstr on the text of a lexeme
+ * Input:
+ *      a token stream ADT, one of its lexemes and a word to find
+ * Output:
+ *      a pointer to the first occurrence of the word in the lexeme, NULL if none
+ *****************/
+const char *lexemeFind(myTokenStream ts, myLexeme lx, const char *word) {
+    const char *text = lexemeText(ts, lx);
+    int n = strlen(word);
+    int i;
+    for (i = 0; i + n <= lx->len; i++) {
+        if (text[i] == word[0] && memcmp(text + i, word, n) == 0) return text + i;
+    }
+    return NULL;
+}
+
+
+/*****************
+ * Function:
+ *      lexemeCopy
+ * Description:
+ *      Copy the text of a lexeme into a string, cut to the size of the string
+ * Input:
+ *      a token stream ADT, one of its lexemes, the string and its size
+ * Output:
+ *      the string, null terminated
+ *****************/
+char *lexemeCopy(myTokenStream ts, myLexeme lx, char *out, int size) {
+    int n = (lx->len < size) ? lx->len : size - 1;
+    memcpy(out, lexemeText(ts, lx), n);
+    out[n] = '\0';
+    return out;
+}
+
+
+/*****************
+ * Function:
+ *      lexemeError
+ * Description:
+ *      Same as hasTokenError for a lexeme
+ * Input:
+ *      a token stream ADT and one of its lexemes
+ * Output:
+ *      1 for an error token, a token reading "EOF" or an empty token, 0 otherwise
+ *****************/
+int lexemeError(myTokenStream ts, myLexeme lx) {
+    const char *text = lexemeText(ts, lx);
+    if (lx->len == 0) return 1;
+    if (lx->len == 7 && memcmp(text, "[Error]", 7) == 0) return 1;
+    if (lx->len == 3 && memcmp(text, "EOF", 3) == 0) return 1;
+    return 0;
+}
+
+
+/*****************
+ * Function:
+ *      clearTokenStream
+ * Description:
+ *      free up memory used by a token stream ADT (the scanner is kept)
+ * Input:
+ *      a token stream ADT
+ * Output:
+ *      released memory previously occupied by the token stream ADT
+ *****************/
+void clearTokenStream(myTokenStream ts) {
+    if (ts != NULL) {
+        free(ts->tokens);
+        free(ts->pool);
+        free(ts);
+    }
+}
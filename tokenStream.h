@@ -0,0 +1,167 @@
+/*
+ ============================================================================
+ Name        : tokenStream.h
+ Author      : NGUYEN, TAM N
+ Created on  : 13NOV16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : A token stream holds the tokens of a scanner in one growable,
+                contiguous array of compact lexemes (see token.h). Tokens are
+                scanned on demand, the first time they are asked for, so
+                scanner messages come out in the same order as before.
+                The text of a lexeme is a slice of the scanner's source: it is
+                never copied. When the scanner reads a stream block by block
+                instead, the texts are appended to a text pool owned by the
+                token stream, and only the tokens from the last one given out
+                are kept, so a stream is scanned in constant memory.
+                Lexeme texts are NOT null terminated, use the functions below.
+                When the scanner allows several threads (see useThreads) and
+                holds a large source in memory, the source is cut into chunks
+                at new lines and the chunks are scanned in parallel the first
+                time a token is asked for; the token arrays are then stitched
+                together and their lines fixed up. The lexical rules have no
+                construct spanning lines, so the tokens are the same as with
+                one thread. Scanner errors of those tokens are printed when the
+                tokens are given out, in the same order as with one thread.
+
+ ============================================================================
+ */
+
+#ifndef _TOKENSTREAM_H_
+#define _TOKENSTREAM_H_
+
+#include <stdio.h>
+#include "./scanner.h"
+#include "./token.h"
+
+//configuration : initial sizes, both arrays double when full
+#define streamTokens (1024)
+#define streamPool (4096)
+
+typedef struct TokenStream *myTokenStream;
+struct TokenStream {
+    myScanner scanner;              // where the tokens come from
+    struct Lexeme *tokens;          // tokens scanned so far (kept ones, for a stream)
+    long first;                     // position of tokens[0] in the stream
+    long count;                     // number of tokens in tokens
+    long capacity;                  // room in tokens
+    char *pool;                     // texts of the lexemes, when the scanner reads a stream
+    long poolLen;
+    long poolCap;
+    long ahead;                     // tokens scanned in parallel, their errors are printed when given out
+    long reported;                  // tokens given out so far among those
+};
+
+
+/*****************
+ * Function:
+ *      openTokenStream
+ * Description:
+ *      Create a token stream reading tokens from a scanner
+ * Input:
+ *      a scanner ADT
+ * Output:
+ *      a token stream ADT, NULL if there is no scanner
+ *****************/
+myTokenStream openTokenStream(myScanner s);
+
+
+/*****************
+ * Function:
+ *      streamToken
+ * Description:
+ *      Give the token at a position of the stream, scanning tokens until
+ *      that position is reached. Past the end of the source, the scanner
+ *      keeps giving EOF tokens.
+ *      The lexeme stays valid until the next call (the array may move).
+ *      For a stream scanner, positions before the last one given out are
+ *      forgotten: tokens must be asked for in order.
+ * Input:
+ *      a token stream ADT and a position (0 for the first token)
+ * Output:
+ *      a lexeme
+ *****************/
+myLexeme streamToken(myTokenStream ts, long i);
+
+
+/*****************
+ * Function:
+ *      streamAll
+ * Description:
+ *      Scan every token of the source at once (see parallelParser.h). The
+ *      scanner messages are still printed when the tokens are given out.
+ *      Once it returns a count, the stream may be read by several threads.
+ * Input:
+ *      a token stream ADT with no token given out yet
+ * Output:
+ *      the number of tokens, the EOF one included; -1 if one of them is an
+ *      error token or if the scanner reads a stream
+ *****************/
+long streamAll(myTokenStream ts);
+
+
+/*****************
+ * Function:
+ *      lexemeText
+ * Description:
+ *      Locate the text of a lexeme (not null terminated, see lx->len)
+ * Input:
+ *      a token stream ADT and one of its lexemes
+ * Output:
+ *      a pointer to the first character of the lexeme
+ *****************/
+const char *lexemeText(myTokenStream ts, myLexeme lx);
+
+
+/*****************
+ * Function:
+ *      lexemeFind
+ * Description:
+ *      Same as strstr on the text of a lexeme
+ * Input:
+ *      a token stream ADT, one of its lexemes and a word to find
+ * Output:
+ *      a pointer to the first occurrence of the word in the lexeme, NULL if none
+ *****************/
+const char *lexemeFind(myTokenStream ts, myLexeme lx, const char *word);
+
+
+/*****************
+ * Function:
+ *      lexemeCopy
+ * Description:
+ *      Copy the text of a lexeme into a string, cut to the size of the string
+ * Input:
+ *      a token stream ADT, one of its lexemes, the string and its size
+ * Output:
+ *      the string, null terminated
+ *****************/
+char *lexemeCopy(myTokenStream ts, myLexeme lx, char *out, int size);
+
+
+/*****************
+ * Function:
+ *      lexemeError
+ * Description:
+ *      Same as hasTokenError for a lexeme
+ * Input:
+ *      a token stream ADT and one of its lexemes
+ * Output:
+ *      1 for an error token, a token reading "EOF" or an empty token, 0 otherwise
+ *****************/
+int lexemeError(myTokenStream ts, myLexeme lx);
+
+
+/*****************
+ * Function:
+ *      clearTokenStream
+ * Description:
+ *      free up memory used by a token stream ADT (the scanner is kept)
+ * Input:
+ *      a token stream ADT
+ * Output:
+ *      released memory previously occupied by the token stream ADT
+ *****************/
+void clearTokenStream(myTokenStream ts);
+
+#endif
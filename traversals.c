@@ -17,397 +17,326 @@
 
 #include "buildTree.h"
 #include "traversals.h"
+#include "stringTable.h"
+#include "writer.h"
+#include "visitor.h"
 
-char asmFooter[100];
+//name printed for a node: the whole identifier for <ID> nodes, the value otherwise
+static const char *nodeName (myCompiler c, Treeptr node) {
+	if (node->symbol != noSymbol) return symbolName(c->symbols, node->symbol);
+	return node->value;
+}
 
-//save results to file
-int saveLog (const char *filename, char *message) {
-	FILE *f_ptr;
-	f_ptr=fopen( filename,"a");
+//name of the storage of a variable in the ASM: its slot once layoutStorage gave
+//it one (see storage.h), its name otherwise
+static const char *storageName (myCompiler c, Treeptr node, char *buffer, int size) {
+	if (c->slots == 0 || node->slot < 0) return nodeName(c, node);
+	snprintf(buffer, size, "V%d", node->slot);
+	return buffer;
+}
 
-	fprintf(f_ptr, "%s",message);
+//add lines to the ASM footer of a compilation
+static void appendFooter (myCompiler c, const char *text) {
+	appendText(c->footer, text, strlen(text));
+}
 
-	return fclose(f_ptr);
+//instruction of a binary operator of <expr>, NULL if the value is not one
+static const char *opInstruction (const char *op) {
+	if (strcmp(op, "+") == 0) return "ADD";
+	if (strcmp(op, "-") == 0) return "SUB";
+	if (strcmp(op, "*") == 0) return "MUL";
+	if (strcmp(op, "/") == 0) return "DIV";
+	return NULL;
 }
 
-void TravInOrder (Treeptr node, int level, const char *filename){
-	int theLevel = level;
-	int temp = 0;
-	char message[1000];
-	char buffer[1000];
-	if (node != NULL){
-		TravInOrder(node->left, theLevel+1,filename);
-		if (filename == NULL) {
-			for (temp = 0; temp<=theLevel; temp++) printf("  ");
-			printf("%d:%d \n", node->data, node->count);
-		} else
-		{
-			for (temp = 0; temp<=theLevel; temp++) strcat(message,"  ");
-			sprintf(buffer, "%d:%d \n", node->data, node->count);
-			strcat (message, buffer);
-			saveLog (filename, message);
-			strncpy(buffer, "", sizeof(buffer));
-			strncpy(message, "", sizeof(message));
-		}
-		TravInOrder(node->right, theLevel+1,filename);
+//indentation of a node of a tree dump
+static void writeIndent (myWriter w, int level) {
+	int temp;
+	for (temp = 0; temp<=level; temp++) writeText(w, "  ", 2);
+}
+
+//writer of an output of a compilation: its text when it has one, the file otherwise
+static myWriter outputWriter (myTextBuffer out, const char *filename) {
+	if (out != NULL) return textWriter(out);
+	return fileWriter(filename);
+}
+
+//a tree dump being written
+struct DumpState {
+	myCompiler c;           // NULL for the in/postorder dumps
+	myWriter w;
+	int onStdout;           // 1 for the name and depth of the nodes, 0 for their name and value
+};
+
+//the line of a node in a tree dump
+static void dumpNode (struct DumpState *d, Treeptr node, int level) {
+	writeIndent(d->w, level);
+	if (d->onStdout) printWriter(d->w, "%s:%d \n", node->data, node->count);
+	else printWriter(d->w, "%s %s \n", node->data, nodeName(d->c, node));
+}
+
+//inorder: the first child, the node, then the other children
+static int inOrderNext (void *state, Treeptr node, int level, int step, Treeptr *child) {
+	if (step == 0 && node->nChildren > 0) {
+		*child = node->children[0];
+		return 1;
 	}
+	if (step <= 1) dumpNode(state, node, level);
+	if (step == 0 || step >= node->nChildren) return 0;
+	*child = node->children[step];
+	return 1;
 }
 
-void TravPreOrder (Treeptr node, int level, const char *filename){
-	int theLevel = level;
-	int temp = 0;
-	char message[1000];
-	char buffer[1000];
-	if (node != NULL){
-		if (filename == NULL) {
-			for (temp = 0; temp<=theLevel; temp++) printf("  ");
-			printf("%s:%d \n", node->data, node->count);
-		} else
-		{
-			for (temp = 0; temp<=theLevel; temp++) strcat(message,"  ");
-			//sprintf(buffer, "%s(%d) %s \n", node->data,string2int(node->data), node->value);
-			sprintf(buffer, "%s %s \n", node->data, node->value);
-			strcat (message, buffer);
-			saveLog (filename, message);
-			strncpy(buffer, "", sizeof(buffer));
-			strncpy(message, "", sizeof(message));
-		}
-		TravPreOrder(node->left, theLevel+1,filename);
-		TravPreOrder(node->right, theLevel+1,filename);
+//preorder: the node, then its children
+static int preOrderEnter (void *state, Treeptr node, int level) {
+	dumpNode(state, node, level);
+	return 1;
+}
+
+//postorder: the children, then the node
+static void postOrderExit (void *state, Treeptr node, int level) {
+	dumpNode(state, node, level);
+}
+
+//the tree in order, to a file or to stdout; 0 if it was written, -1 otherwise
+int TravInOrder (Treeptr node, int level, const char *filename){
+	struct DumpState d;
+	struct Visitor v = {NULL, inOrderNext, NULL, NULL};
+	d.c = NULL;
+	d.w = (filename == NULL) ? streamWriter(stdout) : fileWriter(filename);
+	d.onStdout = 1;
+	v.state = &d;
+	visitTree(node, level, &v);
+	return closeWriter(d.w);
+}
+
+//the tree dump, to the tree text of the compilation, a file or stdout (the
+//name and depth of the nodes); 0 if it was written, -1 otherwise
+int TravPreOrder (myCompiler c, Treeptr node, int level, const char *filename){
+	struct DumpState d;
+	struct Visitor v = {preOrderEnter, NULL, NULL, NULL};
+	if (node == NULL) return 0;
+	d.c = c;
+	d.onStdout = (filename == NULL && c->treeOut == NULL);
+	d.w = d.onStdout ? streamWriter(stdout) : outputWriter(c->treeOut, filename);
+	v.state = &d;
+	visitTree(node, level, &v);
+	return closeWriter(d.w);
+}
+
+//the tree in postorder, to a file or to stdout; 0 if it was written, -1 otherwise
+int TravPostOrder (Treeptr node, int level, const char *filename){
+	struct DumpState d;
+	struct Visitor v = {NULL, NULL, postOrderExit, NULL};
+	d.c = NULL;
+	d.w = (filename == NULL) ? streamWriter(stdout) : fileWriter(filename);
+	d.onStdout = 1;
+	v.state = &d;
+	visitTree(node, level, &v);
+	return closeWriter(d.w);
+}
+
+//an ASM program being written
+struct AsmState {
+	myCompiler c;
+	myWriter w;
+	int loops;             // <Loop> nodes open
+};
+
+//declare the slots of the data section up to a slot, each once: the data
+//section grows with the stack of the open scopes
+static void declareSlots (myCompiler c, int slot) {
+	char temp[100];
+	for (; c->slotsDeclared<=slot; c->slotsDeclared++) {
+		snprintf(temp, sizeof(temp), "V%d 0\n", c->slotsDeclared);
+		appendFooter(c, temp);
 	}
-	
 }
 
-void TravPostOrder (Treeptr node, int level, const char *filename){
-	int theLevel = level;
-	int temp = 0;
-	char message[1000];
-	char buffer[1000];
-
-	if (node != NULL){
-		TravPostOrder(node->left, theLevel+1,filename);
-		TravPostOrder(node->right, theLevel+1,filename);
-		if (filename == NULL) {
-			for (temp = 0; temp<=theLevel; temp++) printf("  ");
-			printf("%d:%d \n", node->data, node->count);
-		} else
+//store 0 in a slot, which may hold the variable of a sibling block
+static void resetSlot (myWriter w, int slot) {
+	char temp[100];
+	snprintf(temp, sizeof(temp), "LOAD 0\nSTORE V%d\n", slot);
+	writeText(w, temp, strlen(temp));
+}
+
+//1 if a node is an <expr> or an <RO> computing its children into a temporary
+static int usesTemporary (Treeptr node) {
+	if (strstr(node->data,"<RO>")!=NULL) return 1;
+	return strstr(node->data,"<expr>")!=NULL && opInstruction(node->value) != NULL;
+}
+
+//the branches of an <If> or a <Loop> on the value of its <RO>, loaded into the
+//accumulator (left side minus right side), then the label of its block
+static void writeBranch (myWriter w, Treeptr node) {
+	char temp[100];
+	memset(temp,0,sizeof(temp));
+	if (strcmp(treeChild(node, 0)->value,"<")==0)
+		snprintf(temp, sizeof(temp), "BRNEG BLOCK%d\nBR END%d\n", node->label, node->label);
+	if (strcmp(treeChild(node, 0)->value,"<=<")==0)
+		snprintf(temp, sizeof(temp), "BRZNEG BLOCK%d\nBR END%d\n", node->label, node->label);
+	if (strcmp(treeChild(node, 0)->value,">")==0)
+		snprintf(temp, sizeof(temp), "BRPOS BLOCK%d\nBR END%d\n", node->label, node->label);
+	if (strcmp(treeChild(node, 0)->value,">=>")==0)
+		snprintf(temp, sizeof(temp), "BRZPOS BLOCK%d\nBR END%d\n", node->label, node->label);
+	if (strcmp(treeChild(node, 0)->value,"=!=")==0)
+		snprintf(temp, sizeof(temp), "BRPOS BLOCK%d\nBRNEG BLOCK%d\nBR END\n", node->label, node->label);
+	if (strcmp(treeChild(node, 0)->value,"=")==0)
+		snprintf(temp, sizeof(temp), "BRZERO BLOCK%d\nBR END\n", node->label);
+	writeText(w, temp, strlen(temp));
+	snprintf(temp, sizeof(temp), "BLOCK%d: NOOP\n", node->label);
+	writeText(w, temp, strlen(temp));
+}
+
+//code of a node reached: the leaves (<INT>, <ID>) write theirs and have no
+//children to visit, a <Loop> starts with its label; a variable starts at 0
+//where it is declared, in a <Loop> before the outermost one instead
+static int asmEnter (void *state, Treeptr node, int level){
+	struct AsmState *a = state;
+	myCompiler c = a->c;
+	char temp[100];
+	char name[25];
+	int slot;
+	memset(temp,0,sizeof(temp));           //preventing mem issues
+
+	if (strstr(node->data,"<INT>")!=NULL) {
+		sprintf(temp, "LOAD %s\n", node->value);
+		writeText(a->w, temp, strlen(temp));
+		return 0;
+	}
+
+	if (strstr(node->data,"<ID>")!=NULL) {
+		if (strstr(node->parent->data,"<vars>")!=NULL && c->slots > 0)
 		{
-			for (temp = 0; temp<=theLevel; temp++) strcat(message,"  ");
-			sprintf(buffer, "%d:%d \n", node->data, node->count);
-			strcat (message, buffer);
-			saveLog (filename, message);
-			strncpy(buffer, "", sizeof(buffer));
-			strncpy(message, "", sizeof(message));
+			declareSlots(c, node->slot);
+			if (a->loops == 0) resetSlot(a->w, node->slot);
 		}
+		else if (strstr(node->parent->data,"<vars>")!=NULL)
+		{
+			snprintf(temp, sizeof(temp), "%s 0\n", nodeName(c, node));
+			appendFooter(c, temp);
+		}
+		else if (strstr(node->parent->data,"<In>")!=NULL)
+		{
+			snprintf(temp, sizeof(temp), "READ %s\n", storageName(c, node, name, sizeof(name)));
+			writeText(a->w, temp, strlen(temp));
+		}
+		else
+		{
+			snprintf(temp, sizeof(temp), "LOAD %s\n", storageName(c, node, name, sizeof(name)));
+			writeText(a->w, temp, strlen(temp));
+		}
+		return 0;
+	}
+
+	if (strstr(node->data,"<Loop>")!=NULL) {
+		if (a->loops++ == 0 && c->slots > 0) {
+			declareSlots(c, node->slotsEnd - 1);
+			for (slot = node->slot; slot < node->slotsEnd; slot++) resetSlot(a->w, slot);
+		}
+		snprintf(temp, sizeof(temp), "BEGIN%d: NOOP\n", node->label);
+		writeText(a->w, temp, strlen(temp));
 	}
+	return 1;
 }
 
-//generate ASM codes based on pre-order tree traversal
-void generateASM (Treeptr node, const char *filename){
-	char asmBody[100];
+//children of a node in the order of its code, with the code written between
+//them; the other nodes visit their children in order
+static int asmNext (void *state, Treeptr node, int level, int step, Treeptr *child){
+	struct AsmState *a = state;
+	myCompiler c = a->c;
 	char temp[100];
-	if (node != NULL){
-		if (filename == NULL) {
-			fprintf(stderr,"[ERROR] Name of ASM file out put not specified.\n");
-		} else
-		{
-		   memset(temp,0,sizeof(temp));           //preventing mem issues
-           
-           //Generating body of ASM file
-           if (strstr(node->data,"<INT>")!=NULL && node->asmFlag==0) {
-               sprintf(temp, "LOAD %s\n", node->value);
-               saveLog(filename, temp);
-               node->asmFlag = 1;
-           }
-
-           
-           if (strstr(node->data,"<Out>")!=NULL && node->asmFlag==0) {
-               if (node->left != NULL) generateASM (node->left, filename);
-               if (node->right != NULL) generateASM (node->right, filename);
-               snprintf(temp, sizeof(temp), "STORE Ttemp\nWRITE Ttemp\n");
-               saveLog(filename, temp);
-               memset (temp,0,sizeof(temp));
-               node->asmFlag = 1;
-           }
-
-           
-           if (strstr(node->data,"<ID>")!=NULL && node->asmFlag==0) {
-               if (strstr(node->parent->data,"<vars>")!=NULL || strstr(node->parent->data,"<mvars>")!=NULL)
-               {
-                   snprintf(temp, sizeof(temp), "%s 0\n", node->value);
-                   strcat(asmFooter, temp);
-                   node->asmFlag = 1;
-               } 
-               else if (strstr(node->parent->data,"<In>")!=NULL)
-               {
-                   memset (temp,0,sizeof(temp));
-                   sprintf(temp, "READ %s\n", node->value);
-                   saveLog(filename, temp);
-                   node->asmFlag = 1;
-               }
-               else
-               {
-                   snprintf(temp, sizeof(temp), "LOAD %s\n", node->value);
-                   saveLog(filename, temp);
-                   node->asmFlag = 1;
-               }
-               
-           }
-           
-           if (strstr(node->data,"<expr>")!=NULL && node->asmFlag==0) {
-                    if (strstr(node->value,"+")!=NULL && node->asmFlag==0)
-                    {
-                        generateASM (node->right, filename);
-                        snprintf(temp, sizeof(temp), "STORE T%d\n", node->count);
-                        saveLog(filename, temp);
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "T%d 0\n", node->count);
-                        strcat(asmFooter, temp);
-                        //right hand side will be calculated and loaded into accumulator
-                        generateASM (node->left, filename);
-                        snprintf(temp, sizeof(temp), "ADD T%d\n", node->count);
-                        saveLog(filename, temp);
-    
-                        node->asmFlag = 1;
-                    }               
-            }
-            
-            if (strstr(node->data,"<M>")!=NULL && node->asmFlag==0) {
-                    if (strstr(node->value,"-")!=NULL && node->asmFlag==0)
-                    {
-                        generateASM (node->right, filename);
-                        snprintf(temp, sizeof(temp), "STORE T%d\n", node->count);
-                        saveLog(filename, temp);
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "T%d 0\n", node->count);
-                        strcat(asmFooter, temp);
-                        //right hand side will be calculated and loaded into accumulator
-                        generateASM (node->left, filename);
-                        snprintf(temp, sizeof(temp), "SUB T%d\n", node->count);
-                        saveLog(filename, temp);
-    
-                        node->asmFlag = 1;
-                    }               
-            }
-            
-            if (strstr(node->data,"<T>")!=NULL && node->asmFlag==0) {
-                    if (strstr(node->value,"*")!=NULL && node->asmFlag==0)
-                    {
-                        generateASM (node->right, filename);
-                        snprintf(temp, sizeof(temp), "STORE T%d\n", node->count);
-                        saveLog(filename, temp);
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "T%d 0\n", node->count);
-                        strcat(asmFooter, temp);
-                        //right hand side will be calculated and loaded into accumulator
-                        generateASM (node->left, filename);
-                        snprintf(temp, sizeof(temp), "MUL T%d\n", node->count);
-                        saveLog(filename, temp);
-    
-                        node->asmFlag = 1;
-                    }
-                    
-                    if (strstr(node->value,"/")!=NULL && node->asmFlag==0)
-                    {
-                        generateASM (node->right, filename);
-                        snprintf(temp, sizeof(temp), "STORE T%d\n", node->count);
-                        saveLog(filename, temp);
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "T%d 0\n", node->count);
-                        strcat(asmFooter, temp);
-                        //right hand side will be calculated and loaded into accumulator
-                        generateASM (node->left, filename);
-                        snprintf(temp, sizeof(temp), "DIV T%d\n", node->count);
-                        saveLog(filename, temp);
-    
-                        node->asmFlag = 1;
-                    } 
-            }
-            
-            if (strstr(node->data,"<assign>")!=NULL && node->asmFlag==0) {
-                    //load the right hand side here
-                    generateASM (node->right, filename);
-                    //right hand side will be calculated and loaded into accumulator
-                    snprintf(temp, sizeof(temp), "STORE %s\n", node->left->value);
-                    saveLog(filename, temp);
-                    node->asmFlag = 1;
-                
-            }
-            
-            if (strstr(node->data,"<F>")!=NULL && node->asmFlag==0) {
-                if (strstr(node->value,"-")!=NULL){
-                    //load the right hand side here
-                    generateASM (node->left, filename);
-                    snprintf(temp, sizeof(temp), "MUL -1\n", node->count);
-                    saveLog(filename, temp);
-                    memset (temp,0,sizeof(temp));
-                    node->asmFlag = 1; 
-                }
-            }
-            
-            if (strstr(node->data,"<If>")!=NULL && node->asmFlag==0) {
-                    //load the condition
-                    generateASM (node->left, filename);
-                    //value of <RO> will be loaded to Accumulator
-                    //left side minus right side
-                    if (strcmp(node->left->value,"<")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRNEG BLOCK%d\nBR END%d\n", node->count, node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    if (strcmp(node->left->value,"<=<")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRZNEG BLOCK%d\nBR END%d\n", node->count, node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    if (strcmp(node->left->value,">")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRPOS BLOCK%d\nBR END%d\n", node->count, node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    if (strcmp(node->left->value,">=>")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRZPOS BLOCK%d\nBR END%d\n", node->count, node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    if (strcmp(node->left->value,"=!=")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRPOS BLOCK%d\nBRNEG BLOCK%d\nBR END\n", node->count, node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    if (strcmp(node->left->value,"=")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRZERO BLOCK%d\nBR END\n", node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    memset (temp,0,sizeof(temp));
-                    snprintf(temp, sizeof(temp), "BLOCK%d: NOOP\n", node->count);
-                    saveLog(filename, temp);
-                    
-                    
-                    //load the right hand side
-                    generateASM (node->right, filename);
-                    //end of right hand side
-                    
-                    memset (temp,0,sizeof(temp));
-                    snprintf(temp, sizeof(temp), "END%d: NOOP\n", node->count);
-                    saveLog(filename, temp);
-                    
-                    memset (temp,0,sizeof(temp));
-                    
-                    node->asmFlag = 1;
-                
-            }
-            
-            if (strstr(node->data,"<Loop>")!=NULL && node->asmFlag==0) {
-                    //load the condition
-                    memset (temp,0,sizeof(temp));
-                    snprintf(temp, sizeof(temp), "BEGIN%d: NOOP\n", node->count);
-                    saveLog(filename, temp);
-                    generateASM (node->left, filename);
-                    //value of <RO> will be loaded to Accumulator
-                    //left side minus right side
-                    if (strcmp(node->left->value,"<")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRNEG BLOCK%d\nBR END%d\n", node->count, node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    if (strcmp(node->left->value,"<=<")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRZNEG BLOCK%d\nBR END%d\n", node->count, node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    if (strcmp(node->left->value,">")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRPOS BLOCK%d\nBR END%d\n", node->count, node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    if (strcmp(node->left->value,">=>")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRZPOS BLOCK%d\nBR END%d\n", node->count, node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    if (strcmp(node->left->value,"=!=")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRPOS BLOCK%d\nBRNEG BLOCK%d\nBR END\n", node->count, node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    if (strcmp(node->left->value,"=")==0)
-                    {
-                        memset (temp,0,sizeof(temp));
-                        snprintf(temp, sizeof(temp), "BRZERO BLOCK%d\nBR END\n", node->count);
-                        saveLog(filename, temp);
-                    }
-                    
-                    memset (temp,0,sizeof(temp));
-                    snprintf(temp, sizeof(temp), "BLOCK%d: NOOP\n", node->count);
-                    saveLog(filename, temp);
-                    
-                    
-                    //load the right hand side
-                    generateASM (node->right, filename);
-                    //end of right hand side
-                    
-                    memset (temp,0,sizeof(temp));
-                    snprintf(temp, sizeof(temp), "BR BEGIN%d\nEND%d: NOOP\n", node->count, node->count);
-                    saveLog(filename, temp);
-                    
-                    memset (temp,0,sizeof(temp));
-                    
-                    node->asmFlag = 1;
-                
-            }
-            
-            if (strstr(node->data,"<RO>")!=NULL && node->asmFlag==0) {
-                    generateASM (node->right, filename);
-                    snprintf(temp, sizeof(temp), "STORE T%d\n", node->count);
-                    saveLog(filename, temp);
-                    memset (temp,0,sizeof(temp));
-                    snprintf(temp, sizeof(temp), "T%d 0\n", node->count);
-                    strcat(asmFooter, temp);
-                    //right hand side will be calculated and loaded into accumulator
-                    generateASM (node->left, filename);
-                    snprintf(temp, sizeof(temp), "SUB T%d\n", node->count);
-                    saveLog(filename, temp);
-
-                    node->asmFlag = 1;              
-            }
+	char name[25];
+	memset(temp,0,sizeof(temp));
 
+	if (usesTemporary(node)) {
+		//the right hand side is stored in the temporary, then the left hand
+		//side is loaded into the accumulator and combined with it
+		if (step == 0) *child = treeChild(node, 1);
+		if (step == 1) {
+			snprintf(temp, sizeof(temp), "STORE T%d\n", node->label);
+			writeText(a->w, temp, strlen(temp));
+			snprintf(temp, sizeof(temp), "T%d 0\n", node->label);
+			if (node->asmFlag == 0 || strstr(node->data,"<RO>")!=NULL) appendFooter(c, temp);   // a shared expression declares its temporary once
+			if (strstr(node->data,"<expr>")!=NULL) node->asmFlag = 1;
+			*child = treeChild(node, 0);
+		}
+		if (step == 2) {
+			if (strstr(node->data,"<RO>")!=NULL) snprintf(temp, sizeof(temp), "SUB T%d\n", node->label);
+			else snprintf(temp, sizeof(temp), "%s T%d\n", opInstruction(node->value), node->label);
+			writeText(a->w, temp, strlen(temp));
 		}
-		if (node->left != NULL && node->asmFlag==0) generateASM(node->left,filename);
-		if (node->right != NULL&& node->asmFlag==0) generateASM(node->right,filename);
-		
-        //Generating footer of ASM file
-		if (node->parent == NULL) {
-		    
-		    saveLog(filename, "STOP\nTtemp 0\n");
-		    if (strcmp(asmFooter, "") != 0) 
-		    {saveLog (filename, asmFooter);}
-	     }
-
-		//--end of ASM footer----
+		return step < 2;
+	}
+
+	if (strstr(node->data,"<assign>")!=NULL) {
+		//load the right hand side here, then store it
+		if (step == 0) *child = treeChild(node, 1);
+		if (step == 1) {
+			snprintf(temp, sizeof(temp), "STORE %s\n", storageName(c, treeChild(node, 0), name, sizeof(name)));
+			writeText(a->w, temp, strlen(temp));
+		}
+		return step < 1;
+	}
+
+	if (strstr(node->data,"<neg>")!=NULL && strstr(node->value,"-")!=NULL) {
+		if (step == 0) *child = treeChild(node, 0);
+		if (step == 1) writeText(a->w, "MUL -1\n", strlen("MUL -1\n"));
+		return step < 1;
+	}
+
+	if (strstr(node->data,"<If>")!=NULL || strstr(node->data,"<Loop>")!=NULL) {
+		//the condition, the branches, then the block
+		if (step == 0) *child = treeChild(node, 0);
+		if (step == 1) {
+			writeBranch(a->w, node);
+			*child = treeChild(node, 1);
+		}
+		if (step == 2) {
+			if (strstr(node->data,"<Loop>")!=NULL) snprintf(temp, sizeof(temp), "BR BEGIN%d\nEND%d: NOOP\n", node->label, node->label);
+			else snprintf(temp, sizeof(temp), "END%d: NOOP\n", node->label);
+			writeText(a->w, temp, strlen(temp));
+		}
+		return step < 2;
+	}
+
+	if (step >= node->nChildren) return 0;
+	*child = node->children[step];
+	return 1;
+}
+
+//code of a node once its children are done: the output of an <Out>, the
+//footer of the program at the root
+static void asmExit (void *state, Treeptr node, int level){
+	struct AsmState *a = state;
+	if (strstr(node->data,"<Loop>")!=NULL) a->loops--;
+	if (strstr(node->data,"<Out>")!=NULL)
+		writeText(a->w, "STORE Ttemp\nWRITE Ttemp\n", strlen("STORE Ttemp\nWRITE Ttemp\n"));
+
+	//Generating footer of ASM file
+	if (node->parent == NULL) {
+		writeText(a->w, "STOP\nTtemp 0\n", strlen("STOP\nTtemp 0\n"));
+		if (a->c->footer->len != 0)
+		{writeText(a->w, a->c->footer->text, a->c->footer->len);}
+	}
+}
+
+
+//generate the ASM program of a tree based on pre-order tree traversal, to the
+//ASM text of the compilation or to a file; a shared expression (see exprDag.h)
+//writes its code each time it is used. 0 if it was written, -1 otherwise
+int generateASM (myCompiler c, Treeptr node, const char *filename){
+	struct AsmState a;
+	struct Visitor v = {asmEnter, asmNext, asmExit, NULL};
+	if (node == NULL) return 0;
+	if (filename == NULL && c->asmOut == NULL) {
+		diagnose(c, stderr,"[ERROR] Name of ASM file out put not specified.\n");
+		return -1;
 	}
-	
+	a.c = c;
+	a.w = outputWriter(c->asmOut, filename);
+	a.loops = 0;
+	v.state = &a;
+	visitTree(node, 0, &v);
+	return closeWriter(a.w);
 }
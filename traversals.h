@@ -14,8 +14,13 @@
 #ifndef TRAVERSALS_H_
 #define TRAVERSALS_H_
 
-void TravInOrder (Treeptr, int, const char*);
-void TravPreOrder (Treeptr, int, const char*);
-void TravPostOrder (Treeptr, int, const char*);
+#include "./buildTree.h"
+
+//the outputs are written through a buffered writer (see writer.h): 0 once
+//written, -1 if they could not be (errno tells why)
+int TravInOrder (Treeptr, int, const char*);
+int TravPreOrder (myCompiler, Treeptr, int, const char*);
+int TravPostOrder (Treeptr, int, const char*);
+int generateASM (myCompiler, Treeptr, const char*);
 
 #endif /* TRAVERSALS_H_ */
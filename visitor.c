@@ -0,0 +1,77 @@
+/*
+ ============================================================================
+ Name        : visitor.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the tree walks declared in visitor.h
+ Functions	 : void visitTree (Treeptr root, int level, myVisitor v)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "./visitor.h"
+
+//a node being visited
+struct VisitFrame {
+    Treeptr node;
+    int level;
+    int step;                       // next step of the node, -1 before it is entered
+};
+
+
+/*****************
+ * Function:
+ *      visitTree
+ * Description:
+ *      The frame on top of the stack is the node being visited: it is
+ *      entered first, then asked for its next child, which is pushed,
+ *      until it has none left; it is then exited and popped
+ * Input:
+ *      the root (may be NULL), its level and the pass
+ * Output:
+ *      none, the work of the hooks
+ *****************/
+void visitTree (Treeptr root, int level, myVisitor v) {
+    struct VisitFrame *stack, *f;
+    long n = 0, room = visitFrames;
+    Treeptr child;
+    int more;
+
+    if (root == NULL) return;
+    stack = malloc(room * sizeof(struct VisitFrame));
+    stack[n].node = root;
+    stack[n].level = level;
+    stack[n++].step = -1;
+    while (n > 0) {
+        f = &stack[n - 1];
+        child = NULL;
+        more = 1;
+        if (f->step < 0) {
+            f->step = 0;
+            if (v->enter != NULL) more = v->enter(v->state, f->node, f->level);
+        }
+        if (more && v->next != NULL) more = v->next(v->state, f->node, f->level, f->step++, &child);
+        else if (more) {
+            more = (f->step < f->node->nChildren);
+            if (more) child = f->node->children[f->step++];
+        }
+        if (!more) {                                                // its children are done
+            if (v->exit != NULL) v->exit(v->state, f->node, f->level);
+            n--;
+            continue;
+        }
+        if (child == NULL) continue;
+        if (n == room) {
+            room *= 2;
+            stack = realloc(stack, room * sizeof(struct VisitFrame));
+        }
+        stack[n].node = child;
+        stack[n].level = stack[n - 1].level + 1;
+        stack[n++].step = -1;
+    }
+    free(stack);
+}
@@ -0,0 +1,59 @@
+/*
+ ============================================================================
+ Name        : visitor.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Walks of a tree without recursion. The nodes being visited
+                are kept on a stack in the heap, a few bytes each, so the
+                depth of a tree is bounded by memory, not by the call stack.
+                A pass is a set of hooks: enter is called when a node is
+                reached (preorder), exit once its children are done
+                (postorder), and next, when given, chooses the children and
+                their order one step at a time, so a pass can write between
+                two children (inorder, code generation).
+                Used by the tree dumps and the ASM generator (traversals.c),
+                the scope checks (scopeCheck.c), the storage layout
+                (storage.c) and the shared expressions (exprDag.c).
+
+ ============================================================================
+ */
+
+#ifndef _VISITOR_H_
+#define _VISITOR_H_
+
+#include "./buildTree.h"
+
+//configuration : frames of the stack of a walk before it grows (doubled when full)
+#define visitFrames (256)
+
+typedef struct Visitor *myVisitor;
+struct Visitor {
+    //called when a node is reached: 1 to visit its children, 0 to leave them out; NULL to visit them
+    int (*enter) (void *state, Treeptr node, int level);
+    //called at steps 0, 1, ... of a node: 1 with *child the next node to visit
+    //(NULL for none yet), 0 once its children are done; NULL for the children in order
+    int (*next) (void *state, Treeptr node, int level, int step, Treeptr *child);
+    //called once the children of a node are done, or left out; may be NULL
+    void (*exit) (void *state, Treeptr node, int level);
+    void *state;                    // the data of the pass, given to the hooks
+};
+
+
+/*****************
+ * Function:
+ *      visitTree
+ * Description:
+ *      Walk a tree depth first, calling the hooks of a pass on every node.
+ *      A node reached from several parents (see exprDag.h) is visited each
+ *      time
+ * Input:
+ *      the root (may be NULL), its level (given back to the hooks, one more
+ *      for each generation) and the pass
+ * Output:
+ *      none, the work of the hooks
+ *****************/
+void visitTree (Treeptr root, int level, myVisitor v);
+
+#endif
@@ -0,0 +1,228 @@
+/*
+ ============================================================================
+ Name        : writer.c
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Implementation of the buffered output writer declared in writer.h
+ Functions	 : myWriter newWriter ()
+                myWriter fileWriter (const char *filename)
+                myWriter streamWriter (FILE *stream)
+                myWriter textWriter (myTextBuffer text)
+                void writeText (myWriter w, const char *text, long len)
+                void printWriter (myWriter w, const char *format, ...)
+                int flushWriter (myWriter w)
+                int closeWriter (myWriter w)
+ ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "./writer.h"
+
+
+/*****************
+ * Function:
+ *      newWriter
+ * Description:
+ *      Create a writer to nothing yet, its constructor sets the target
+ * Input:
+ *      none
+ * Output:
+ *      a writer ADT without a buffer
+ *****************/
+static myWriter newWriter () {
+    myWriter w = malloc(sizeof(struct Writer));
+    w->filename = NULL;
+    w->fd = -1;
+    w->stream = NULL;
+    w->text = NULL;
+    w->buffer = NULL;
+    w->used = 0;
+    w->error = 0;
+    return w;
+}
+
+
+/*****************
+ * Function:
+ *      fileWriter
+ * Description:
+ *      Create a writer appending to a file through a buffer of
+ *      writerBuffer bytes; the file is opened (created if needed) when
+ *      the buffer is first written out
+ * Input:
+ *      a file name, kept by the caller until the writer is closed
+ * Output:
+ *      a writer ADT
+ *****************/
+myWriter fileWriter (const char *filename) {
+    myWriter w = newWriter();
+    w->filename = filename;
+    w->buffer = malloc(writerBuffer);
+    return w;
+}
+
+
+/*****************
+ * Function:
+ *      streamWriter
+ * Description:
+ *      Create a writer to a stream (e.g. stdout) through a buffer of
+ *      writerBuffer bytes, the stream is flushed with the writer
+ * Input:
+ *      an open stream, left open when the writer is closed
+ * Output:
+ *      a writer ADT
+ *****************/
+myWriter streamWriter (FILE *stream) {
+    myWriter w = newWriter();
+    w->stream = stream;
+    w->buffer = malloc(writerBuffer);
+    return w;
+}
+
+
+/*****************
+ * Function:
+ *      textWriter
+ * Description:
+ *      Create a writer appending to a text buffer in memory, with no
+ *      buffer of its own
+ * Input:
+ *      a text buffer ADT, left to the caller
+ * Output:
+ *      a writer ADT
+ *****************/
+myWriter textWriter (myTextBuffer text) {
+    myWriter w = newWriter();
+    w->text = text;
+    return w;
+}
+
+
+/*****************
+ * Function:
+ *      flushWriter
+ * Description:
+ *      Write out the buffer: to the file with as many write calls as it
+ *      takes (the file is opened by the first one), or to the stream,
+ *      which is flushed
+ * Input:
+ *      a writer ADT
+ * Output:
+ *      0 if everything was written, -1 after an error
+ *****************/
+int flushWriter (myWriter w) {
+    long done = 0, n;
+    if (w->error == 0 && w->used > 0 && w->filename != NULL) {
+        if (w->fd < 0) w->fd = open(w->filename, O_WRONLY | O_CREAT | O_APPEND, 0666);
+        if (w->fd < 0) w->error = errno;
+        while (w->error == 0 && done < w->used) {
+            n = write(w->fd, w->buffer + done, w->used - done);
+            if (n >= 0) done += n;
+            else if (errno != EINTR) w->error = errno;
+        }
+    } else if (w->error == 0 && w->stream != NULL) {
+        if (w->used > 0 && fwrite(w->buffer, 1, w->used, w->stream) != (size_t)w->used) w->error = errno ? errno : EIO;
+        if (w->error == 0 && fflush(w->stream) != 0) w->error = errno;
+    }
+    w->used = 0;
+    return w->error ? -1 : 0;
+}
+
+
+/*****************
+ * Function:
+ *      writeText
+ * Description:
+ *      Write text, straight to a text buffer, through the buffer
+ *      otherwise: the buffer is written out first when the text does not
+ *      fit, and a text larger than the buffer is written out at once
+ * Input:
+ *      a writer ADT, the text (not necessarily null terminated) and its length
+ * Output:
+ *      none, an error is kept for closeWriter
+ *****************/
+void writeText (myWriter w, const char *text, long len) {
+    if (w->error != 0 || len <= 0) return;
+    if (w->text != NULL) {
+        appendText(w->text, text, len);
+        return;
+    }
+    if (w->used + len > writerBuffer) flushWriter(w);
+    if (len > writerBuffer) {
+        while (len > 0 && w->error == 0) {
+            memcpy(w->buffer, text, (len > writerBuffer) ? writerBuffer : len);
+            w->used = (len > writerBuffer) ? writerBuffer : len;
+            text += w->used;
+            len -= w->used;
+            flushWriter(w);
+        }
+        return;
+    }
+    memcpy(w->buffer + w->used, text, len);
+    w->used += len;
+}
+
+
+/*****************
+ * Function:
+ *      printWriter
+ * Description:
+ *      Write formatted text, as fprintf would: formatted on the stack,
+ *      in memory of its own when it is longer than a line of 1024 bytes
+ * Input:
+ *      a writer ADT, a format and its arguments
+ * Output:
+ *      none, an error is kept for closeWriter
+ *****************/
+void printWriter (myWriter w, const char *format, ...) {
+    char line[1024], *text = line;
+    va_list args;
+    int len;
+    va_start(args, format);
+    len = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (len < 0) return;
+    if (len >= (int)sizeof(line)) {                         // a long text, formatted again in memory of its own
+        text = malloc(len + 1);
+        va_start(args, format);
+        vsnprintf(text, len + 1, format, args);
+        va_end(args);
+    }
+    writeText(w, text, len);
+    if (text != line) free(text);
+}
+
+
+/*****************
+ * Function:
+ *      closeWriter
+ * Description:
+ *      Write out the buffer, close the file and free up memory used by the
+ *      writer ADT. The stream and the text are left to the caller
+ * Input:
+ *      a writer ADT (may be NULL)
+ * Output:
+ *      0 if everything was written, -1 after an error (errno tells which)
+ *****************/
+int closeWriter (myWriter w) {
+    int error;
+    if (w == NULL) return 0;
+    flushWriter(w);
+    if (w->fd >= 0 && close(w->fd) != 0 && w->error == 0) w->error = errno;
+    error = w->error;
+    free(w->buffer);
+    free(w);
+    if (error == 0) return 0;
+    errno = error;
+    return -1;
+}
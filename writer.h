@@ -0,0 +1,136 @@
+/*
+ ============================================================================
+ Name        : writer.h
+ Author      : NGUYEN, TAM N
+ Created on  : 11DEC16
+ Version     : 1
+ Copyright   : (CC)
+ Summary	 : Buffered output writer. An output is opened once, the text is
+                gathered in a large buffer and written out when the buffer is
+                full and when the writer is closed. The output is a file
+                (one descriptor for the whole output, opened in append mode
+                on the first write, so an output with no text creates no
+                file), a stream such as stdout, or a text buffer in memory
+                (see textBuffer.h). The first error is kept and given back
+                by closeWriter, nothing is written after it.
+                Used by the tree dumps and the ASM generator (traversals.c).
+
+ ============================================================================
+ */
+
+#ifndef _WRITER_H_
+#define _WRITER_H_
+
+#include <stdio.h>
+#include <stdarg.h>
+#include "./textBuffer.h"
+
+//configuration : bytes gathered before they are written to a file or a stream
+#define writerBuffer (65536)
+
+typedef struct Writer *myWriter;
+struct Writer {
+    const char *filename;           // file written, NULL for a stream or a text
+    int fd;                         // descriptor of the file, -1 until it is opened
+    FILE *stream;                   // stream written, NULL for a file or a text
+    myTextBuffer text;              // text written, NULL for a file or a stream
+    char *buffer;                   // bytes not written yet (files and streams)
+    long used;
+    int error;                      // 0, or the errno of the first error
+};
+
+
+/*****************
+ * Function:
+ *      fileWriter
+ * Description:
+ *      Create a writer appending to a file, which is opened (created if
+ *      needed) on the first write
+ * Input:
+ *      a file name, kept by the caller until the writer is closed
+ * Output:
+ *      a writer ADT
+ *****************/
+myWriter fileWriter (const char *filename);
+
+
+/*****************
+ * Function:
+ *      streamWriter
+ * Description:
+ *      Create a writer to a stream (e.g. stdout), which is flushed with
+ *      the writer so the text keeps its place among other writes
+ * Input:
+ *      an open stream, left open when the writer is closed
+ * Output:
+ *      a writer ADT
+ *****************/
+myWriter streamWriter (FILE *stream);
+
+
+/*****************
+ * Function:
+ *      textWriter
+ * Description:
+ *      Create a writer appending to a text buffer in memory
+ * Input:
+ *      a text buffer ADT, left to the caller
+ * Output:
+ *      a writer ADT
+ *****************/
+myWriter textWriter (myTextBuffer text);
+
+
+/*****************
+ * Function:
+ *      writeText
+ * Description:
+ *      Write text, kept in the buffer until it is full
+ * Input:
+ *      a writer ADT, the text (not necessarily null terminated) and its length
+ * Output:
+ *      none, an error is kept for closeWriter
+ *****************/
+void writeText (myWriter w, const char *text, long len);
+
+
+/*****************
+ * Function:
+ *      printWriter
+ * Description:
+ *      Write formatted text, as fprintf would
+ * Input:
+ *      a writer ADT, a format and its arguments
+ * Output:
+ *      none, an error is kept for closeWriter
+ *****************/
+void printWriter (myWriter w, const char *format, ...);
+
+
+/*****************
+ * Function:
+ *      flushWriter
+ * Description:
+ *      Write out the text gathered so far
+ * Input:
+ *      a writer ADT
+ * Output:
+ *      0 if everything was written, -1 after an error
+ *****************/
+int flushWriter (myWriter w);
+
+
+/*****************
+ * Function:
+ *      closeWriter
+ * Description:
+ *      Write out the text left, close the file and free up memory used by
+ *      the writer ADT
+ * Input:
+ *      a writer ADT (may be NULL)
+ * Output:
+ *      0 if everything was written, -1 after an error (errno tells which)
+ *****************/
+int closeWriter (myWriter w);
+
+#endif